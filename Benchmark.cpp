@@ -0,0 +1,471 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <set>
+#include <cstring>
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "DynamicAllocator.h"
+
+// Build with optimizations and the instruction set of the machine, e.g.: g++ -std=c++17 -O2 -march=native -pthread Benchmark.cpp
+
+using namespace harz;
+using namespace harz::DynamicAllocatorDetails;
+using BenchmarkClock = std::chrono::steady_clock;
+
+// List of NodesCount adjacent nodes with random sizes, every second node is free.
+// Memory of nodes is never touched, so addresses are made up
+template<typename NodeStorage>
+void FillNodes(NodeStorage& Nodes, uint32 NodesCount)
+{
+	std::mt19937 Random{ 42 };
+	Nodes.reserve(NodesCount);
+	uintptr_t NodeAddress = 0x10000000;
+	for (uint32 nodeIndex = 0; nodeIndex < NodesCount; nodeIndex++)
+	{
+		MemoryHeaderBlockNode Node{};
+		// Even sizes only, so odd requested size never has an exact match and the whole list is searched
+		Node.Size = 16 + (Random() % 2048) * 2;
+		Node.NodeMemory = (void*)NodeAddress;
+		NodeAddress += Node.Size;
+		Node.IsBlockFree = nodeIndex % 2;
+		Node.NextNodeIndex = nodeIndex + 1 < NodesCount ? nodeIndex + 1 : InvalidNodeID;
+		Node.PrevNodeIndex = nodeIndex > 0 ? nodeIndex - 1 : InvalidNodeID;
+		Node.IsNextNodeAdjacent = nodeIndex + 1 < NodesCount;
+		Node.IsPrevNodeAdjacent = nodeIndex > 0;
+		Nodes.push_back(Node);
+	}
+}
+
+// Microseconds per best fit search through all the nodes
+template<typename FreeBlockIndex, typename NodeStorage>
+double MeasureBestFitSearch(uint32 NodesCount, uint32& FoundNodeIndex)
+{
+	NodeStorage Nodes{};
+	FillNodes(Nodes, NodesCount);
+	FreeBlockIndex FreeIndex{};
+	for (uint32 nodeIndex = 1; nodeIndex < NodesCount; nodeIndex += 2)
+		FreeIndex.Insert(Nodes, nodeIndex);
+
+	const int Iterations = 200 * 1000 * 1000 / NodesCount;
+	auto Start = BenchmarkClock::now();
+	for (int i = 0; i < Iterations; i++)
+		FoundNodeIndex = FreeIndex.Find(Nodes, 0, 3001 + (i & 1) * 2);
+	auto End = BenchmarkClock::now();
+	return std::chrono::duration<double, std::micro>(End - Start).count() / Iterations;
+}
+
+// Scalar kernel over the same contiguous arrays, shows the gain of SIMD itself
+class ScalarBestFitIndex : public VectorizedBestFitIndex
+{
+public:
+	template<typename NodeStorage>
+	inline uint32 Find(const NodeStorage& Nodes, uint32, uint32 size)
+	{
+		return FindBestFitScalar(Nodes.GetSizes(), Nodes.GetFreeFlags(), (uint32)Nodes.size(), size);
+	};
+};
+
+// Walk through the list of nodes comparing their addresses one by one
+class ChainWalkAddressIndex : public HashAddressIndex
+{
+public:
+	template<typename NodeStorage>
+	inline uint32 Find(const NodeStorage& Nodes, void* address) const
+	{
+		for (uint32 nodeIndex = 0; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
+		{
+			if (Nodes.at(nodeIndex).NodeMemory == address)
+				return Nodes.at(nodeIndex).IsBlockFree == 0 ? nodeIndex : InvalidNodeID;
+		}
+		return InvalidNodeID;
+	};
+};
+
+// Scalar kernel over the same contiguous array of addresses
+class ScalarAddressIndex : public VectorizedAddressIndex
+{
+public:
+	template<typename NodeStorage>
+	inline uint32 Find(const NodeStorage& Nodes, void* address) const
+	{
+		uint32 NodeIndex = FindPointerScalar(Nodes.GetPointers(), (uint32)Nodes.size(), address);
+		return NodeIndex != InvalidNodeID && Nodes.GetFreeFlags()[NodeIndex] == 0 ? NodeIndex : InvalidNodeID;
+	};
+};
+
+// Microseconds per lookup of a random occupied node by its address
+template<typename OccupiedBlockIndex, typename NodeStorage>
+double MeasureAddressLookup(uint32 NodesCount, uint32& FoundNodesSum)
+{
+	NodeStorage Nodes{};
+	FillNodes(Nodes, NodesCount);
+	OccupiedBlockIndex OccupiedIndex{};
+	std::vector<void*> Addresses{};
+	for (uint32 nodeIndex = 0; nodeIndex < NodesCount; nodeIndex += 2)
+	{
+		OccupiedIndex.Insert(Nodes, nodeIndex);
+		Addresses.push_back(Nodes.at(nodeIndex).NodeMemory);
+	}
+	std::mt19937 Random{ 7 };
+	std::shuffle(Addresses.begin(), Addresses.end(), Random);
+
+	const int Iterations = 100 * 1000 * 1000 / NodesCount;
+	FoundNodesSum = 0;
+	auto Start = BenchmarkClock::now();
+	for (int i = 0; i < Iterations; i++)
+		FoundNodesSum += OccupiedIndex.Find(Nodes, Addresses[i % Addresses.size()]);
+	auto End = BenchmarkClock::now();
+	return std::chrono::duration<double, std::micro>(End - Start).count() / Iterations;
+}
+
+// Resident memory of the process in bytes, 0 if it is unknown on this platform
+size_t GetResidentMemory()
+{
+#if defined(__linux__)
+	std::ifstream Statm{ "/proc/self/statm" };
+	size_t TotalPages = 0, ResidentPages = 0;
+	Statm >> TotalPages >> ResidentPages;
+	return ResidentPages * (size_t)sysconf(_SC_PAGESIZE);
+#else
+	return 0;
+#endif
+}
+
+// Microseconds per construction of an allocator, all instances stay alive to measure their resident memory
+double MeasureConstruction(MetadataReservation Reservation, uint32 InstancesCount, size_t& ResidentMemoryPerInstance)
+{
+	std::vector<std::unique_ptr<DynamicAllocator<>>> Instances{};
+	Instances.reserve(InstancesCount);
+	size_t ResidentMemoryBefore = GetResidentMemory();
+	auto Start = BenchmarkClock::now();
+	for (uint32 i = 0; i < InstancesCount; i++)
+		Instances.emplace_back(new DynamicAllocator<>{ 64 * 1024, MaxAllocationsDefault, Reservation });
+	auto End = BenchmarkClock::now();
+	size_t ResidentMemoryAfter = GetResidentMemory();
+	ResidentMemoryPerInstance = ResidentMemoryAfter > ResidentMemoryBefore ? (ResidentMemoryAfter - ResidentMemoryBefore) / InstancesCount : 0;
+	return std::chrono::duration<double, std::micro>(End - Start).count() / InstancesCount;
+}
+
+// Nanoseconds per Allocate/Free pair on a working set of random sized allocations
+template<typename AllocatorType>
+double MeasureAllocateFree(uint32 AllocationsCount)
+{
+	AllocatorType Allocator{ 64 * 1024 * 1024, AllocationsCount * 2 };
+	std::mt19937 Random{ 3 };
+	std::vector<void*> Allocations(AllocationsCount, nullptr);
+	std::vector<uint32> Sizes(AllocationsCount);
+	for (uint32& Size : Sizes)
+		Size = 64 + Random() % 4096;
+
+	const int Iterations = 4 * 1000 * 1000;
+	auto Start = BenchmarkClock::now();
+	for (int i = 0; i < Iterations; i++)
+	{
+		uint32 AllocationIndex = Random() % AllocationsCount;
+		if (Allocations[AllocationIndex] != nullptr)
+			Allocator.Free(Allocations[AllocationIndex]);
+		Allocations[AllocationIndex] = Allocator.Allocate(Sizes[AllocationIndex]);
+	}
+	auto End = BenchmarkClock::now();
+	for (void* Allocation : Allocations)
+		Allocator.Free(Allocation);
+	return std::chrono::duration<double, std::nano>(End - Start).count() / Iterations;
+}
+
+// Bytes of metadata per allocation, metadata isn't reserved up front
+template<typename AllocatorType>
+double MeasureMetadataPerAllocation(uint32 AllocationsCount)
+{
+	AllocatorType Allocator{ 64 * 1024 * 1024, AllocationsCount, MetadataReservation::Lazy };
+	std::vector<void*> Allocations(AllocationsCount, nullptr);
+	for (void*& Allocation : Allocations)
+		Allocation = Allocator.Allocate(300);
+	double MetadataSize = (double)Allocator.GetMetadataSize() / AllocationsCount;
+	for (void* Allocation : Allocations)
+		Allocator.Free(Allocation);
+	return MetadataSize;
+}
+
+// Nanoseconds per increment, every thread increments the counter in its own allocation,
+// allocations are made one after another, so without granularity they are neighbors in the same cache line
+template<typename AllocatorType>
+double MeasureNeighborWrites(uint32 ThreadsCount, uint32& CacheLinesCount)
+{
+	AllocatorType Allocator{ 64 * 1024 };
+	std::vector<std::atomic<uint64>*> Counters{};
+	std::set<uintptr_t> CacheLines{};
+	for (uint32 i = 0; i < ThreadsCount; i++)
+	{
+		Counters.push_back(new (Allocator.Allocate(sizeof(std::atomic<uint64>))) std::atomic<uint64>{ 0 });
+		CacheLines.insert((uintptr_t)Counters.back() / 64);
+	}
+	CacheLinesCount = (uint32)CacheLines.size();
+
+	const uint64 Increments = 20 * 1000 * 1000;
+	std::vector<std::thread> Threads{};
+	auto Start = BenchmarkClock::now();
+	for (std::atomic<uint64>* Counter : Counters)
+		Threads.emplace_back([Counter, Increments]() { for (uint64 i = 0; i < Increments; i++) Counter->fetch_add(1, std::memory_order_relaxed); });
+	for (std::thread& Thread : Threads)
+		Thread.join();
+	auto End = BenchmarkClock::now();
+
+	for (std::atomic<uint64>* Counter : Counters)
+		Allocator.Free(Counter);
+	return std::chrono::duration<double, std::nano>(End - Start).count() / Increments;
+}
+
+// Resident memory after a burst of allocations and after freeing most of them,
+// every 16th allocation stays alive, so free blocks lie between occupied ones
+template<typename AllocatorType>
+double MeasureBurstResidentMemory(size_t& ResidentMemoryAfterBurst, size_t& ResidentMemoryAfterFree)
+{
+	const uint32 AllocationsCount = 2048;
+	const uint32 AllocationSize = 64 * 1024;
+	AllocatorType Allocator{ 160 * 1024 * 1024 };
+	size_t ResidentMemoryBefore = GetResidentMemory();
+	std::vector<void*> Allocations(AllocationsCount, nullptr);
+	for (void*& Allocation : Allocations)
+		Allocation = std::memset(Allocator.Allocate(AllocationSize), 1, AllocationSize);
+	ResidentMemoryAfterBurst = GetResidentMemory() - ResidentMemoryBefore;
+
+	auto Start = BenchmarkClock::now();
+	for (uint32 i = 0; i < AllocationsCount; i++)
+		if (i % 16 != 0)
+			Allocator.Free(Allocations[i]);
+	auto End = BenchmarkClock::now();
+	ResidentMemoryAfterFree = GetResidentMemory() - ResidentMemoryBefore;
+
+	for (uint32 i = 0; i < AllocationsCount; i += 16)
+		Allocator.Free(Allocations[i]);
+	return std::chrono::duration<double, std::nano>(End - Start).count() / (AllocationsCount - AllocationsCount / 16);
+}
+
+// Milliseconds for StepsCount calls of Resize, each of them grows the allocator by StepSize.
+// IsCoalesced is set when all the free space can be taken by one allocation afterwards without growth
+template<typename AllocatorType>
+double MeasureResizeSteps(uint32 StepsCount, uint32 StepSize, bool& IsCoalesced)
+{
+	AllocatorType Allocator{ StepSize };
+	auto Start = BenchmarkClock::now();
+	for (uint32 i = 0; i < StepsCount; i++)
+		Allocator.Resize(Allocator.GetTotalSize() + StepSize);
+	auto End = BenchmarkClock::now();
+
+	const auto TotalSize = Allocator.GetTotalSize();
+	IsCoalesced = Allocator.Allocate(Allocator.GetFreeSpaceSize()) != nullptr && Allocator.GetTotalSize() == TotalSize;
+	return std::chrono::duration<double, std::milli>(End - Start).count();
+}
+
+// Counter of data TLB misses of this thread, Read returns -1 if the system doesn't give the counter(e.g. perf_event_paranoid)
+class DataTLBMissCounter
+{
+public:
+	DataTLBMissCounter()
+	{
+#if defined(__linux__)
+		perf_event_attr Attributes{};
+		Attributes.size = sizeof(Attributes);
+		Attributes.type = PERF_TYPE_HW_CACHE;
+		Attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		Attributes.exclude_kernel = 1;
+		Attributes.exclude_hv = 1;
+		Descriptor = (int)syscall(SYS_perf_event_open, &Attributes, 0, -1, -1, 0);
+#endif
+	};
+	~DataTLBMissCounter()
+	{
+#if defined(__linux__)
+		if (Descriptor >= 0)
+			close(Descriptor);
+#endif
+	};
+
+	int64_t Read() const
+	{
+#if defined(__linux__)
+		uint64 Count = 0;
+		if (Descriptor >= 0 && read(Descriptor, &Count, sizeof(Count)) == sizeof(Count))
+			return (int64_t)Count;
+#endif
+		return -1;
+	};
+
+private:
+	int Descriptor = -1;
+};
+
+// Nanoseconds per hop of pointer chasing through 4KB allocations linked in random order,
+// every hop goes to another 4KB page, so with small pages nearly every hop misses TLB
+template<typename AllocatorType>
+double MeasurePointerChasing(uint32 AllocationsCount, double& TLBMissesPerHop)
+{
+	const uint32 AllocationSize = 4096;
+	AllocatorType Allocator{ (AllocationsCount + 1) * AllocationSize };
+	std::vector<void**> Allocations(AllocationsCount, nullptr);
+	for (void**& Allocation : Allocations)
+		Allocation = (void**)Allocator.Allocate(AllocationSize);
+	std::shuffle(Allocations.begin(), Allocations.end(), std::mt19937{ 5 });
+	for (uint32 i = 0; i < AllocationsCount; i++)
+		*Allocations[i] = Allocations[(i + 1) % AllocationsCount];
+
+	const uint32 Hops = 20 * 1000 * 1000;
+	DataTLBMissCounter TLBMisses{};
+	void** Current = Allocations[0];
+	int64_t TLBMissesBefore = TLBMisses.Read();
+	auto Start = BenchmarkClock::now();
+	for (uint32 i = 0; i < Hops; i++)
+		Current = (void**)*Current;
+	auto End = BenchmarkClock::now();
+	int64_t TLBMissesAfter = TLBMisses.Read();
+	TLBMissesPerHop = TLBMissesBefore >= 0 && TLBMissesAfter >= 0 ? (double)(TLBMissesAfter - TLBMissesBefore) / Hops : -1.0;
+
+	// Keep the chase from being optimized away
+	if (Current == nullptr)
+		std::cout << "";
+	for (void** Allocation : Allocations)
+		Allocator.Free(Allocation);
+	return std::chrono::duration<double, std::nano>(End - Start).count() / Hops;
+}
+
+int main()
+{
+	std::cout << "Best fit search(microseconds per search through all nodes)\n";
+#if defined(DYNAMIC_ALLOCATOR_AVX2)
+	std::cout << "Vectorized kernel: AVX2\n";
+#elif defined(DYNAMIC_ALLOCATOR_SSE41)
+	std::cout << "Vectorized kernel: SSE4.1\n";
+#else
+	std::cout << "Vectorized kernel: scalar\n";
+#endif
+	std::cout << std::setw(10) << "Nodes" << std::setw(16) << "ListScan AoS" << std::setw(16) << "ListScan SoA"
+		<< std::setw(16) << "Scalar SoA" << std::setw(16) << "Vectorized SoA" << std::setw(10) << "Speedup" << '\n';
+
+	for (uint32 NodesCount : { 10 * 1000, 100 * 1000, 1000 * 1000 })
+	{
+		uint32 Found[4] = {};
+		double ListAoS = MeasureBestFitSearch<LinearScanIndex<>, AoSNodeStorage>(NodesCount, Found[0]);
+		double ListSoA = MeasureBestFitSearch<LinearScanIndex<>, SoANodeStorage>(NodesCount, Found[1]);
+		double Scalar = MeasureBestFitSearch<ScalarBestFitIndex, SoANodeStorage>(NodesCount, Found[2]);
+		double Vectorized = MeasureBestFitSearch<VectorizedBestFitIndex, SoANodeStorage>(NodesCount, Found[3]);
+		std::cout << std::setw(10) << NodesCount << std::fixed << std::setprecision(2) << std::setw(16) << ListAoS << std::setw(16) << ListSoA
+			<< std::setw(16) << Scalar << std::setw(16) << Vectorized << std::setw(9) << ListAoS / Vectorized << "x";
+		// All searches must find the same node
+		if (Found[0] != Found[1] || Found[0] != Found[2] || Found[0] != Found[3])
+			std::cout << " MISMATCH";
+		std::cout << '\n';
+	}
+
+	std::cout << "\nFree lookup of allocation by address(microseconds per lookup)\n";
+	std::cout << std::setw(10) << "Nodes" << std::setw(16) << "ChainWalk AoS" << std::setw(16) << "Scalar SoA"
+		<< std::setw(16) << "Vectorized SoA" << std::setw(10) << "Speedup" << std::setw(16) << "HashMap AoS" << '\n';
+
+	for (uint32 NodesCount : { 10 * 1000, 100 * 1000, 1000 * 1000 })
+	{
+		uint32 Found[4] = {};
+		double ChainWalk = MeasureAddressLookup<ChainWalkAddressIndex, AoSNodeStorage>(NodesCount, Found[0]);
+		double Scalar = MeasureAddressLookup<ScalarAddressIndex, SoANodeStorage>(NodesCount, Found[1]);
+		double Vectorized = MeasureAddressLookup<VectorizedAddressIndex, SoANodeStorage>(NodesCount, Found[2]);
+		double HashMap = MeasureAddressLookup<HashAddressIndex, AoSNodeStorage>(NodesCount, Found[3]);
+		std::cout << std::setw(10) << NodesCount << std::fixed << std::setprecision(3) << std::setw(16) << ChainWalk << std::setw(16) << Scalar
+			<< std::setw(16) << Vectorized << std::setw(9) << std::setprecision(2) << ChainWalk / Vectorized << "x" << std::setprecision(3) << std::setw(16) << HashMap;
+		if (Found[0] != Found[1] || Found[0] != Found[2] || Found[0] != Found[3])
+			std::cout << " MISMATCH";
+		std::cout << '\n';
+	}
+
+	std::cout << "\nAllocate/Free with 32 and 64 bit sizes(nanoseconds per pair)\n";
+	std::cout << std::setw(10) << "Live" << std::setw(16) << "uint32 sizes" << std::setw(16) << "uint64 sizes" << '\n';
+	for (uint32 AllocationsCount : { 1000, 10 * 1000 })
+	{
+		double Size32 = MeasureAllocateFree<DynamicAllocator<>>(AllocationsCount);
+		double Size64 = MeasureAllocateFree<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, HashAddressIndex, AoSNodeStorage, uint64>>(AllocationsCount);
+		std::cout << std::setw(10) << AllocationsCount << std::fixed << std::setprecision(1) << std::setw(16) << Size32 << std::setw(16) << Size64 << '\n';
+	}
+
+	const uint32 AllocationsCount = 50 * 1000;
+	std::cout << "\nMetadata with 32 and 16 bit node IDs(bytes per allocation, " << AllocationsCount << " allocations)\n";
+	std::cout << std::setw(10) << "Storage" << std::setw(16) << "uint32 IDs" << std::setw(16) << "uint16 IDs" << '\n';
+	std::cout << std::setw(10) << "AoS" << std::fixed << std::setprecision(1)
+		<< std::setw(16) << MeasureMetadataPerAllocation<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, BoundaryTagIndex, AoSNodeStorage>>(AllocationsCount)
+		<< std::setw(16) << MeasureMetadataPerAllocation<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, BoundaryTagIndex, AoSNodeStorage, uint32, uint16>>(AllocationsCount) << '\n';
+	std::cout << std::setw(10) << "Packed" << std::fixed << std::setprecision(1)
+		<< std::setw(16) << MeasureMetadataPerAllocation<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, BoundaryTagIndex, PackedNodeStorage>>(AllocationsCount)
+		<< std::setw(16) << MeasureMetadataPerAllocation<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, BoundaryTagIndex, PackedNodeStorage, uint32, uint16>>(AllocationsCount) << '\n';
+
+	const uint32 ThreadsCount = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+	std::cout << "\nWrites of " << ThreadsCount << " threads to neighbor allocations(nanoseconds per increment, "
+		<< std::thread::hardware_concurrency() << " hardware threads)\n";
+	std::cout << std::setw(16) << "Allocator" << std::setw(16) << "Nanoseconds" << std::setw(16) << "Cache lines" << '\n';
+	{
+		uint32 CacheLines[2] = {};
+		double Default = MeasureNeighborWrites<DynamicAllocator<>>(ThreadsCount, CacheLines[0]);
+		double Granular = MeasureNeighborWrites<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, GranularIndex<>>>(ThreadsCount, CacheLines[1]);
+		std::cout << std::setw(16) << "Default" << std::fixed << std::setprecision(2) << std::setw(16) << Default << std::setw(16) << CacheLines[0] << '\n';
+		std::cout << std::setw(16) << "Granular 64" << std::fixed << std::setprecision(2) << std::setw(16) << Granular << std::setw(16) << CacheLines[1] << '\n';
+	}
+
+#if defined(__linux__)
+	std::cout << "\nResident memory after burst of 128MB and free of most allocations(MB, nanoseconds per Free)\n";
+	std::cout << std::setw(10) << "Backend" << std::setw(16) << "After burst" << std::setw(16) << "After free" << std::setw(16) << "Free" << '\n';
+	{
+		size_t ResidentMemory[2] = {};
+		double Time = MeasureBurstResidentMemory<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC>>(ResidentMemory[0], ResidentMemory[1]);
+		std::cout << std::setw(10) << "MALLOC" << std::fixed << std::setprecision(1) << std::setw(16) << ResidentMemory[0] / (1024.0 * 1024.0)
+			<< std::setw(16) << ResidentMemory[1] / (1024.0 * 1024.0) << std::setw(16) << Time << '\n';
+		Time = MeasureBurstResidentMemory<DynamicAllocator<DYNAMIC_ALLOCATOR_MMAP>>(ResidentMemory[0], ResidentMemory[1]);
+		std::cout << std::setw(10) << "MMAP" << std::fixed << std::setprecision(1) << std::setw(16) << ResidentMemory[0] / (1024.0 * 1024.0)
+			<< std::setw(16) << ResidentMemory[1] / (1024.0 * 1024.0) << std::setw(16) << Time << '\n';
+	}
+#endif
+
+#if defined(__linux__)
+	const uint32 ResizeStepsCount = 20000;
+	std::cout << "\nResize in " << ResizeStepsCount << " steps of 16KB with PageMapIndex(milliseconds, whether free space is one block)\n";
+	std::cout << std::setw(16) << "Backend" << std::setw(16) << "Milliseconds" << std::setw(16) << "Coalesced" << '\n';
+	{
+		bool IsCoalesced = false;
+		double Time = MeasureResizeSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MMAP, ExplicitFreeListIndex<>, PageMapIndex>>(ResizeStepsCount, 16 * 1024, IsCoalesced);
+		std::cout << std::setw(16) << "MMAP" << std::fixed << std::setprecision(2) << std::setw(16) << Time << std::setw(16) << std::boolalpha << IsCoalesced << '\n';
+		Time = MeasureResizeSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_VIRTUAL_ARENA<>, ExplicitFreeListIndex<>, PageMapIndex>>(ResizeStepsCount, 16 * 1024, IsCoalesced);
+		std::cout << std::setw(16) << "VIRTUAL_ARENA" << std::fixed << std::setprecision(2) << std::setw(16) << Time << std::setw(16) << std::boolalpha << IsCoalesced << '\n';
+	}
+#endif
+
+#if defined(__linux__)
+	const uint32 ChasedAllocationsCount = 64 * 1024;
+	std::cout << "\nPointer chasing through " << ChasedAllocationsCount * 4 / 1024 << "MB of 4KB allocations(per hop, TLB misses -1 if counter isn't available)\n";
+	std::cout << std::setw(12) << "Backend" << std::setw(16) << "Nanoseconds" << std::setw(16) << "TLB misses" << '\n';
+	{
+		double TLBMisses = 0.0;
+		double Time = MeasurePointerChasing<DynamicAllocator<DYNAMIC_ALLOCATOR_MMAP>>(ChasedAllocationsCount, TLBMisses);
+		std::cout << std::setw(12) << "MMAP" << std::fixed << std::setprecision(2) << std::setw(16) << Time << std::setw(16) << TLBMisses << '\n';
+		Time = MeasurePointerChasing<DynamicAllocator<DYNAMIC_ALLOCATOR_HUGE_PAGES>>(ChasedAllocationsCount, TLBMisses);
+		std::cout << std::setw(12) << "HUGE_PAGES" << std::fixed << std::setprecision(2) << std::setw(16) << Time << std::setw(16) << TLBMisses << '\n';
+	}
+#endif
+
+	const uint32 InstancesCount = 500;
+	std::cout << "\nConstruction of allocator with 64KB base size(per instance, " << InstancesCount << " instances alive)\n";
+	std::cout << std::setw(10) << "Mode" << std::setw(16) << "Microseconds" << std::setw(16) << "Resident KB" << '\n';
+	for (MetadataReservation Reservation : { MetadataReservation::Eager, MetadataReservation::Lazy })
+	{
+		size_t ResidentMemory = 0;
+		double Time = MeasureConstruction(Reservation, InstancesCount, ResidentMemory);
+		std::cout << std::setw(10) << (Reservation == MetadataReservation::Eager ? "Eager" : "Lazy") << std::fixed << std::setprecision(2)
+			<< std::setw(16) << Time << std::setw(16) << ResidentMemory / 1024.0 << '\n';
+	}
+	return 0;
+};
@@ -9,6 +9,14 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <limits>
 
 #ifdef DYNAMIC_ALLOCATOR_DEBUG
 #include <cassert>
@@ -29,48 +37,248 @@
 #define DYNAMIC_ALLOCATOR_STATS 0
 #endif
 
+// define 1 to compact metadata from Free when most of the nodes are invalid(see CompactMetadata)
+#ifndef DYNAMIC_ALLOCATOR_AUTO_COMPACT
+#define DYNAMIC_ALLOCATOR_AUTO_COMPACT 0
+#endif
+
+// define 1 to trim metadata from Free when valid nodes drop below the low watermark(see TrimMetadata)
+#ifndef DYNAMIC_ALLOCATOR_AUTO_TRIM
+#define DYNAMIC_ALLOCATOR_AUTO_TRIM 0
+#endif
+
+// define DYNAMIC_ALLOCATOR_SIMD 0 to use only scalar search kernels
+#ifndef DYNAMIC_ALLOCATOR_SIMD
+#define DYNAMIC_ALLOCATOR_SIMD 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// SIMD kernels are compiled for the instruction set targeted by the compiler(-mavx2/-msse4.1, /arch:AVX2)
+#if DYNAMIC_ALLOCATOR_SIMD == 1 && defined(__AVX2__)
+#define DYNAMIC_ALLOCATOR_AVX2 1
+#include <immintrin.h>
+#elif DYNAMIC_ALLOCATOR_SIMD == 1 && defined(__SSE4_1__)
+#define DYNAMIC_ALLOCATOR_SSE41 1
+#include <immintrin.h>
+#endif
+
 #if DYNAMIC_ALLOCATOR_STATS == 1
 #include <string>
 #include <sstream>
 #endif
 
+// DYNAMIC_ALLOCATOR_MMAP, DYNAMIC_ALLOCATOR_HUGE_PAGES and DYNAMIC_ALLOCATOR_VIRTUAL_ARENA internal allocators map memory directly from the kernel
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace harz
 {
 	namespace DynamicAllocatorDetails
 	{
+		using uint64 = unsigned long long;
 		using uint32 = unsigned int;
+		using uint16 = unsigned short;
 		using uint8 = unsigned char;
 
-		constexpr static uint32 FreeIdsUseThreshold = 64;
 		constexpr static uint32 MaxAllocationsDefault = 50 * 1024;
+		// Automatic compaction and trim don't touch small metadata
+		constexpr static uint32 AutoCompactMinNodes = 4096;
+		// Metadata is trimmed when less than 1/MetadataLowWatermarkDivisor of used node slots are valid nodes
+		constexpr static uint32 MetadataLowWatermarkDivisor = 4;
+
+		// When metadata of nodes and indexes gets its memory
+		enum class MetadataReservation : uint8
+		{
+			// Reserve metadata for MaxAllocations nodes in constructor
+			Eager,
+			// Grow metadata by chunks with the number of nodes, construction allocates nothing but the first region
+			Lazy
+		};
 
 		// Overhead of allocation is memory header block size, which in bits is 129 in x64, 
 		// depends on size of pointer which on most user machines will be 64 bits
 		constexpr static uint32 MinAllocSizeRequirement = 256;
+		// Max alignment of AllocateAligned(page size)
+		constexpr static uint32 MaxAllocationAlignment = 4096;
+		// Pages of free block are given back to the system(if internal allocator has Release) when the block is at least this big
+		constexpr static uint32 ReleaseMinBlockSize = 256 * 1024;
 		// Free list must not have such a big number of nodes
+		// (ID of 32 bit node IDs used by SIMD kernels, classes with NodeIDType define InvalidNodeID as the max value of it)
 		constexpr static uint32 InvalidNodeID = 0xFFFFFFFF;
+		constexpr static uint16 InvalidRegionID = 0xFFFF;
+
+		// Index of the lowest set bit, value must not be 0
+		template<typename T>
+		inline uint32 FindLowestSetBit(T value)
+		{
+			static_assert(std::is_integral<T>::value && sizeof(T) <= 8, "Value must be an integer of up to 64 bits");
+#if defined(_MSC_VER)
+			unsigned long index = 0;
+			if (sizeof(T) <= 4)
+				_BitScanForward(&index, (unsigned long)value);
+#if defined(_WIN64)
+			else
+				_BitScanForward64(&index, (uint64)value);
+#else
+			else if ((uint32)value != 0)
+				_BitScanForward(&index, (unsigned long)value);
+			else
+				_BitScanForward(&index, (unsigned long)((uint64)value >> 32)), index += 32;
+#endif
+			return index;
+#else
+			return sizeof(T) <= 4 ? __builtin_ctz((uint32)value) : __builtin_ctzll((uint64)value);
+#endif
+		};
+
+		// Index of the highest set bit, value must not be 0
+		template<typename T>
+		inline uint32 FindHighestSetBit(T value)
+		{
+			static_assert(std::is_integral<T>::value && sizeof(T) <= 8, "Value must be an integer of up to 64 bits");
+#if defined(_MSC_VER)
+			unsigned long index = 0;
+			if (sizeof(T) <= 4)
+				_BitScanReverse(&index, (unsigned long)value);
+#if defined(_WIN64)
+			else
+				_BitScanReverse64(&index, (uint64)value);
+#else
+			else if (((uint64)value >> 32) != 0)
+				_BitScanReverse(&index, (unsigned long)((uint64)value >> 32)), index += 32;
+			else
+				_BitScanReverse(&index, (unsigned long)value);
+#endif
+			return index;
+#else
+			return sizeof(T) <= 4 ? 31 - __builtin_clz((uint32)value) : 63 - __builtin_clzll((uint64)value);
+#endif
+		};
+
+		// Array of fixed-size chunks, it grows by adding a chunk and never moves elements,
+		// so references to elements stay valid and growing past reserved size has no copy of the whole array.
+		// Chunks stay allocated after clear and are reused.
+		// Memory of a chunk is not initialized until elements are added, so untouched reserved chunks cost no resident memory
+		template<typename T, uint32 ChunkSizeLog2 = 12>
+		class ChunkedArray
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Elements of ChunkedArray are never destroyed");
+
+		public:
+			constexpr static uint32 ChunkSize = 1u << ChunkSizeLog2;
+
+			inline T& operator[](size_t Index) { return Chunks[Index >> ChunkSizeLog2]->Elements()[Index & (ChunkSize - 1)]; };
+			inline const T& operator[](size_t Index) const { return Chunks[Index >> ChunkSizeLog2]->Elements()[Index & (ChunkSize - 1)]; };
+
+			// Same behavior as std::vector::at for out of range index
+			inline T& at(size_t Index)
+			{
+				if (Index >= Size)
+					throw std::out_of_range("ChunkedArray::at");
+				return (*this)[Index];
+			};
+			inline const T& at(size_t Index) const
+			{
+				if (Index >= Size)
+					throw std::out_of_range("ChunkedArray::at");
+				return (*this)[Index];
+			};
+
+			inline T& back() { return (*this)[Size - 1]; };
+			inline const T& back() const { return (*this)[Size - 1]; };
+
+			inline size_t size() const { return Size; };
+			inline bool empty() const { return Size == 0; };
+			inline size_t capacity() const { return Chunks.size() << ChunkSizeLog2; };
+
+			// Allocate chunks for Count elements in advance
+			void reserve(size_t Count)
+			{
+				while (capacity() < Count)
+					Chunks.emplace_back(new ChunkMemory);
+			};
+
+			inline void clear() { Size = 0; };
+
+			// Release chunks which have no elements
+			void shrink_to_fit()
+			{
+				Chunks.resize((Size + ChunkSize - 1) >> ChunkSizeLog2);
+				Chunks.shrink_to_fit();
+			};
+
+			inline size_t GetMemorySize() const { return Chunks.capacity() * sizeof(Chunks[0]) + Chunks.size() * sizeof(ChunkMemory); };
+
+			void push_back(const T& Value)
+			{
+				reserve(Size + 1);
+				new (&(*this)[Size]) T(Value);
+				Size++;
+			};
+
+			inline void pop_back() { Size--; };
+
+			// New elements are set to Value
+			void resize(size_t Count, const T& Value = T{})
+			{
+				reserve(Count);
+				for (; Size < Count; Size++)
+					new (&(*this)[Size]) T(Value);
+				Size = Count;
+			};
+
+		private:
+			struct ChunkMemory
+			{
+				inline T* Elements() { return reinterpret_cast<T*>(Memory); };
+				inline const T* Elements() const { return reinterpret_cast<const T*>(Memory); };
+
+				alignas(T) uint8 Memory[sizeof(T) * ChunkSize];
+			};
 
-		struct MemoryHeaderBlockNode
+			std::vector<std::unique_ptr<ChunkMemory>> Chunks{};
+			size_t Size = 0;
+		};
+
+		// Widths of sizes and node IDs are template parameters(see DynamicAllocator)
+		template<typename SizeType = uint32, typename NodeIDType = uint32>
+		struct BasicMemoryHeaderBlockNode
 		{
-			MemoryHeaderBlockNode()
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+
+			BasicMemoryHeaderBlockNode()
 			{
 				Size = 0;
 				NodeMemory = nullptr;
 				NextNodeIndex = InvalidNodeID;
+				PrevNodeIndex = InvalidNodeID;
+				RegionID = InvalidRegionID;
+				IsPrevNodeAdjacent = 0;
 				IsNextNodeAdjacent = 0;
 				IsBlockFree = 1;
 				IsPrimaryAllocated = 0;
 				FreeSpace = 0;
 			};
 
-			uint32 Size = 0;
+			// Pointer goes first, so the node with both links still packs into 24 bytes
 			void* NodeMemory = nullptr;
-			uint32 NextNodeIndex = 0;
+			SizeType Size = 0;
+			NodeIDType NextNodeIndex = 0;
+			NodeIDType PrevNodeIndex = 0;
+			// Region(primary allocated block of memory) this node's memory belongs to
+			uint16 RegionID = InvalidRegionID;
 
 			// ==================== FLAGS
 
 			// For future use
-			uint8 FreeSpace : 5;
+			uint8 FreeSpace : 4;
+			// Adjacent memory flag(to know if previous block of memory in List is "neighbor" to this node's block of memory)
+			uint8 IsPrevNodeAdjacent : 1;
 			// Adjacent memory flag(to know if next block of memory in List is "neighbor" to this node's block of memory)
 			uint8 IsNextNodeAdjacent : 1;
 			uint8 IsBlockFree : 1;
@@ -78,52 +286,2503 @@ namespace harz
 			uint8 IsPrimaryAllocated : 1;
 		};
 
-#if DYNAMIC_ALLOCATOR_USE_MALLOC == 1
-#include <malloc.h>
+		using MemoryHeaderBlockNode = BasicMemoryHeaderBlockNode<>;
 
-		class DYNAMIC_ALLOCATOR_MALLOC
+		// Primary allocated block of memory, received from internal allocator by resize
+		template<typename SizeType = uint32, typename NodeIDType = uint32>
+		struct BasicMemoryRegion
+		{
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+
+			void* Memory = nullptr;
+			SizeType Size = 0;
+			// Memory received from internal allocator, Memory is aligned inside of it by granularity of free block index
+			void* AllocatedMemory = nullptr;
+			// Node which starts at the beginning of the region, it stays the same while region is allocated
+			NodeIDType PrimaryNodeIndex = InvalidNodeID;
+		};
+
+		using MemoryRegion = BasicMemoryRegion<>;
+
+		// ==================== NODE STORAGES
+		// Node storage keeps metadata of all nodes and gives access to a node by its ID with vector-like at/[]/size/push_back.
+		// Reference/ConstReference is what at() returns, it has the same fields as MemoryHeaderBlockNode
+		// and can be assigned from MemoryHeaderBlockNode or converted to it.
+		// InsertRegion is called before nodes of a new region are added, RemoveRegion after all nodes of the region are invalidated.
+		// GetMemorySize returns bytes of memory held by the storage.
+		// Storage of other widths of sizes and node IDs is Rebind<SizeType, NodeIDType>.
+
+		// Reference to one bit of the packed flags
+		template<bool IsConst>
+		class NodeFlagReference
 		{
 		public:
-			using pointer = void*;
+			using ByteType = typename std::conditional<IsConst, const uint8, uint8>::type;
+
+			NodeFlagReference(ByteType& FlagsByte, uint8 FlagMask) : Byte(FlagsByte), Mask(FlagMask) {};
+			// Const reference from non-const one
+			template<bool IsOtherConst, typename = typename std::enable_if<IsConst && !IsOtherConst>::type>
+			NodeFlagReference(const NodeFlagReference<IsOtherConst>& other) : Byte(other.Byte), Mask(other.Mask) {};
+			NodeFlagReference(const NodeFlagReference&) = default;
+
+			inline operator uint8() const { return (Byte & Mask) != 0; };
+			inline NodeFlagReference& operator=(uint8 value)
+			{
+				Byte = value ? (Byte | Mask) : (Byte & ~Mask);
+				return *this;
+			};
+			inline NodeFlagReference& operator=(const NodeFlagReference& other) { return *this = (uint8)other; };
+
+		private:
+			template<bool> friend class NodeFlagReference;
+
+			ByteType& Byte;
+			uint8 Mask;
+		};
+
+		// Array of node records(default), all fields of a node share its cache line
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicAoSNodeStorage
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using NodeType = BasicMemoryHeaderBlockNode<SizeType, NodeIDType>;
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicAoSNodeStorage<OtherSizeType, OtherNodeIDType>;
+			using Reference = NodeType&;
+			using ConstReference = const NodeType&;
+
+			inline Reference at(NodeIDType NodeIndex) { return Nodes.at(NodeIndex); };
+			inline ConstReference at(NodeIDType NodeIndex) const { return Nodes.at(NodeIndex); };
+			inline Reference operator[](NodeIDType NodeIndex) { return Nodes[NodeIndex]; };
+			inline ConstReference operator[](NodeIDType NodeIndex) const { return Nodes[NodeIndex]; };
+
+			inline size_t size() const { return Nodes.size(); };
+			inline bool empty() const { return Nodes.empty(); };
+			inline void reserve(uint32 MaxAllocations) { Nodes.reserve(MaxAllocations); };
+			inline size_t capacity() const { return Nodes.capacity(); };
+			inline void clear() { Nodes.clear(); };
+			inline void push_back(const NodeType& Node) { Nodes.push_back(Node); };
+			inline size_t GetMemorySize() const { return Nodes.GetMemorySize(); };
+			inline void InsertRegion(const RegionType&, uint16) {};
+			inline void RemoveRegion(const RegionType&, uint16) {};
+
+		private:
+			ChunkedArray<NodeType> Nodes{};
+		};
+
+		using AoSNodeStorage = BasicAoSNodeStorage<>;
+
+		// Structure of arrays: sizes, free flags, pointers, links and the rest of the flags are kept in separate arrays,
+		// so a scan through sizes and free flags doesn't pull the rest of the metadata into cache.
+		// Node is accessed through a proxy of references to its fields
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicSoANodeStorage
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using NodeType = BasicMemoryHeaderBlockNode<SizeType, NodeIDType>;
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicSoANodeStorage<OtherSizeType, OtherNodeIDType>;
+			template<bool IsConst>
+			class NodeReference
+			{
+			public:
+				template<typename T>
+				using Field = typename std::conditional<IsConst, const T&, T&>::type;
+				using StorageType = typename std::conditional<IsConst, const BasicSoANodeStorage, BasicSoANodeStorage>::type;
+
+				NodeReference(StorageType& Storage, NodeIDType NodeIndex) :
+					NodeMemory(Storage.Pointers[NodeIndex]),
+					Size(Storage.Sizes[NodeIndex]),
+					NextNodeIndex(Storage.NextNodeIndexes[NodeIndex]),
+					PrevNodeIndex(Storage.PrevNodeIndexes[NodeIndex]),
+					RegionID(Storage.RegionIDs[NodeIndex]),
+					IsPrevNodeAdjacent(Storage.Flags[NodeIndex], PrevNodeAdjacentFlag),
+					IsNextNodeAdjacent(Storage.Flags[NodeIndex], NextNodeAdjacentFlag),
+					IsBlockFree(Storage.FreeFlags[NodeIndex]),
+					IsPrimaryAllocated(Storage.Flags[NodeIndex], PrimaryAllocatedFlag)
+				{};
+
+				// Const reference from non-const one
+				template<bool IsOtherConst, typename = typename std::enable_if<IsConst && !IsOtherConst>::type>
+				NodeReference(const NodeReference<IsOtherConst>& other) :
+					NodeMemory(other.NodeMemory),
+					Size(other.Size),
+					NextNodeIndex(other.NextNodeIndex),
+					PrevNodeIndex(other.PrevNodeIndex),
+					RegionID(other.RegionID),
+					IsPrevNodeAdjacent(other.IsPrevNodeAdjacent),
+					IsNextNodeAdjacent(other.IsNextNodeAdjacent),
+					IsBlockFree(other.IsBlockFree),
+					IsPrimaryAllocated(other.IsPrimaryAllocated)
+				{};
+				NodeReference(const NodeReference&) = default;
+
+				NodeReference& operator=(const NodeType& Node)
+				{
+					NodeMemory = Node.NodeMemory;
+					Size = Node.Size;
+					NextNodeIndex = Node.NextNodeIndex;
+					PrevNodeIndex = Node.PrevNodeIndex;
+					RegionID = Node.RegionID;
+					IsPrevNodeAdjacent = Node.IsPrevNodeAdjacent;
+					IsNextNodeAdjacent = Node.IsNextNodeAdjacent;
+					IsBlockFree = Node.IsBlockFree;
+					IsPrimaryAllocated = Node.IsPrimaryAllocated;
+					return *this;
+				};
+
+				operator NodeType() const
+				{
+					NodeType Node{};
+					Node.NodeMemory = NodeMemory;
+					Node.Size = Size;
+					Node.NextNodeIndex = NextNodeIndex;
+					Node.PrevNodeIndex = PrevNodeIndex;
+					Node.RegionID = RegionID;
+					Node.IsPrevNodeAdjacent = IsPrevNodeAdjacent;
+					Node.IsNextNodeAdjacent = IsNextNodeAdjacent;
+					Node.IsBlockFree = IsBlockFree;
+					Node.IsPrimaryAllocated = IsPrimaryAllocated;
+					return Node;
+				};
+
+				Field<void*> NodeMemory;
+				Field<SizeType> Size;
+				Field<NodeIDType> NextNodeIndex;
+				Field<NodeIDType> PrevNodeIndex;
+				Field<uint16> RegionID;
+				NodeFlagReference<IsConst> IsPrevNodeAdjacent;
+				NodeFlagReference<IsConst> IsNextNodeAdjacent;
+				Field<uint8> IsBlockFree;
+				NodeFlagReference<IsConst> IsPrimaryAllocated;
+			};
+
+			using Reference = NodeReference<false>;
+			using ConstReference = NodeReference<true>;
+
+			inline Reference at(NodeIDType NodeIndex) { CheckRange(NodeIndex); return Reference(*this, NodeIndex); };
+			inline ConstReference at(NodeIDType NodeIndex) const { CheckRange(NodeIndex); return ConstReference(*this, NodeIndex); };
+			inline Reference operator[](NodeIDType NodeIndex) { return Reference(*this, NodeIndex); };
+			inline ConstReference operator[](NodeIDType NodeIndex) const { return ConstReference(*this, NodeIndex); };
+
+			inline size_t size() const { return Sizes.size(); };
+			inline bool empty() const { return Sizes.empty(); };
+
+			// Contiguous arrays for search kernels, indexed by node ID
+			inline const SizeType* GetSizes() const { return Sizes.data(); };
+			inline const uint8* GetFreeFlags() const { return FreeFlags.data(); };
+			inline void* const* GetPointers() const { return Pointers.data(); };
+
+			void reserve(uint32 MaxAllocations)
+			{
+				Pointers.reserve(MaxAllocations);
+				Sizes.reserve(MaxAllocations);
+				NextNodeIndexes.reserve(MaxAllocations);
+				PrevNodeIndexes.reserve(MaxAllocations);
+				RegionIDs.reserve(MaxAllocations);
+				FreeFlags.reserve(MaxAllocations);
+				Flags.reserve(MaxAllocations);
+			};
+
+			inline size_t capacity() const { return Sizes.capacity(); };
+
+			size_t GetMemorySize() const
+			{
+				return Pointers.capacity() * sizeof(void*) + Sizes.capacity() * sizeof(SizeType) + NextNodeIndexes.capacity() * sizeof(NodeIDType)
+					+ PrevNodeIndexes.capacity() * sizeof(NodeIDType) + RegionIDs.capacity() * sizeof(uint16) + FreeFlags.capacity() + Flags.capacity();
+			};
+
+			void clear()
+			{
+				Pointers.clear();
+				Sizes.clear();
+				NextNodeIndexes.clear();
+				PrevNodeIndexes.clear();
+				RegionIDs.clear();
+				FreeFlags.clear();
+				Flags.clear();
+			};
+
+			void push_back(const NodeType& Node)
+			{
+				Pointers.push_back(nullptr);
+				Sizes.push_back(0);
+				// Copy of the constant, so it isn't odr-used(C++14 needs definition of odr-used static members)
+				NextNodeIndexes.push_back(NodeIDType{ InvalidNodeID });
+				PrevNodeIndexes.push_back(NodeIDType{ InvalidNodeID });
+				RegionIDs.push_back(InvalidRegionID);
+				FreeFlags.push_back(1);
+				Flags.push_back(0);
+				(*this)[(NodeIDType)Sizes.size() - 1] = Node;
+			};
+
+			inline void InsertRegion(const RegionType&, uint16) {};
+			inline void RemoveRegion(const RegionType&, uint16) {};
+
+		private:
+			constexpr static uint8 PrevNodeAdjacentFlag = 1 << 0;
+			constexpr static uint8 NextNodeAdjacentFlag = 1 << 1;
+			constexpr static uint8 PrimaryAllocatedFlag = 1 << 2;
+
+			// Same behavior as std::vector::at for out of range node ID
+			inline void CheckRange(NodeIDType NodeIndex) const { (void)Sizes.at(NodeIndex); };
+
+			std::vector<void*> Pointers{};
+			std::vector<SizeType> Sizes{};
+			std::vector<NodeIDType> NextNodeIndexes{};
+			std::vector<NodeIDType> PrevNodeIndexes{};
+			std::vector<uint16> RegionIDs{};
+			std::vector<uint8> FreeFlags{};
+			// Adjacency and primary allocation flags
+			std::vector<uint8> Flags{};
+		};
+
+		using SoANodeStorage = BasicSoANodeStorage<>;
+
+		// Reference to the memory of a node which is stored as an offset in its region
+		template<bool IsConst, typename OffsetT = uint32>
+		class NodePointerReference
+		{
+		public:
+			using OffsetType = typename std::conditional<IsConst, const OffsetT, OffsetT>::type;
+
+			NodePointerReference(OffsetType& NodeOffset, const uint16& NodeRegionID, const std::vector<uint8*>& Regions) :
+				Offset(NodeOffset), RegionID(NodeRegionID), RegionsMemory(Regions) {};
+			template<bool IsOtherConst, typename = typename std::enable_if<IsConst && !IsOtherConst>::type>
+			NodePointerReference(const NodePointerReference<IsOtherConst, OffsetT>& other) :
+				Offset(other.Offset), RegionID(other.RegionID), RegionsMemory(other.RegionsMemory) {};
+			NodePointerReference(const NodePointerReference&) = default;
+
+			// Converts to any pointer type, as void* converts with a cast
+			template<typename T>
+			inline operator T*() const { return (T*)Get(); };
+
+			// Region of the node must be set before its memory
+			inline NodePointerReference& operator=(const void* Memory)
+			{
+				Offset = Memory != nullptr ? (OffsetT)((const uint8*)Memory - RegionsMemory[RegionID]) : 0;
+				return *this;
+			};
+			inline NodePointerReference& operator=(const NodePointerReference& other) { return *this = other.Get(); };
+
+			template<typename T>
+			friend inline bool operator==(const NodePointerReference& Reference, T* Memory) { return Reference.Get() == (const void*)Memory; };
+			template<typename T>
+			friend inline bool operator!=(const NodePointerReference& Reference, T* Memory) { return Reference.Get() != (const void*)Memory; };
+
+		private:
+			template<bool, typename> friend class NodePointerReference;
+
+			inline void* Get() const { return RegionID != InvalidRegionID ? RegionsMemory[RegionID] + Offset : nullptr; };
+
+			OffsetType& Offset;
+			const uint16& RegionID;
+			const std::vector<uint8*>& RegionsMemory;
+		};
+
+		// Array of packed node records: memory of a node is an offset in its region instead of a pointer
+		// and all flags share one byte, so the record is 20 bytes instead of 24(with default widths).
+		// Pointer to the node's memory is rebuilt from the region table on access
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicPackedNodeStorage
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using NodeType = BasicMemoryHeaderBlockNode<SizeType, NodeIDType>;
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicPackedNodeStorage<OtherSizeType, OtherNodeIDType>;
+			struct NodeRecord
+			{
+				SizeType Offset = 0;
+				SizeType Size = 0;
+				NodeIDType NextNodeIndex = InvalidNodeID;
+				NodeIDType PrevNodeIndex = InvalidNodeID;
+				uint16 RegionID = InvalidRegionID;
+				uint8 Flags = FreeFlag;
+			};
+
+			template<bool IsConst>
+			class NodeReference
+			{
+			public:
+				template<typename T>
+				using Field = typename std::conditional<IsConst, const T&, T&>::type;
+				using RecordType = typename std::conditional<IsConst, const NodeRecord, NodeRecord>::type;
+
+				NodeReference(RecordType& Record, const std::vector<uint8*>& RegionsMemory) :
+					NodeMemory(Record.Offset, Record.RegionID, RegionsMemory),
+					Size(Record.Size),
+					NextNodeIndex(Record.NextNodeIndex),
+					PrevNodeIndex(Record.PrevNodeIndex),
+					RegionID(Record.RegionID),
+					IsPrevNodeAdjacent(Record.Flags, PrevNodeAdjacentFlag),
+					IsNextNodeAdjacent(Record.Flags, NextNodeAdjacentFlag),
+					IsBlockFree(Record.Flags, FreeFlag),
+					IsPrimaryAllocated(Record.Flags, PrimaryAllocatedFlag)
+				{};
+
+				// Const reference from non-const one
+				template<bool IsOtherConst, typename = typename std::enable_if<IsConst && !IsOtherConst>::type>
+				NodeReference(const NodeReference<IsOtherConst>& other) :
+					NodeMemory(other.NodeMemory),
+					Size(other.Size),
+					NextNodeIndex(other.NextNodeIndex),
+					PrevNodeIndex(other.PrevNodeIndex),
+					RegionID(other.RegionID),
+					IsPrevNodeAdjacent(other.IsPrevNodeAdjacent),
+					IsNextNodeAdjacent(other.IsNextNodeAdjacent),
+					IsBlockFree(other.IsBlockFree),
+					IsPrimaryAllocated(other.IsPrimaryAllocated)
+				{};
+				NodeReference(const NodeReference&) = default;
+
+				NodeReference& operator=(const NodeType& Node)
+				{
+					RegionID = Node.RegionID;
+					NodeMemory = Node.NodeMemory;
+					Size = Node.Size;
+					NextNodeIndex = Node.NextNodeIndex;
+					PrevNodeIndex = Node.PrevNodeIndex;
+					IsPrevNodeAdjacent = Node.IsPrevNodeAdjacent;
+					IsNextNodeAdjacent = Node.IsNextNodeAdjacent;
+					IsBlockFree = Node.IsBlockFree;
+					IsPrimaryAllocated = Node.IsPrimaryAllocated;
+					return *this;
+				};
+
+				operator NodeType() const
+				{
+					NodeType Node{};
+					Node.NodeMemory = NodeMemory;
+					Node.Size = Size;
+					Node.NextNodeIndex = NextNodeIndex;
+					Node.PrevNodeIndex = PrevNodeIndex;
+					Node.RegionID = RegionID;
+					Node.IsPrevNodeAdjacent = IsPrevNodeAdjacent;
+					Node.IsNextNodeAdjacent = IsNextNodeAdjacent;
+					Node.IsBlockFree = IsBlockFree;
+					Node.IsPrimaryAllocated = IsPrimaryAllocated;
+					return Node;
+				};
+
+				NodePointerReference<IsConst, SizeType> NodeMemory;
+				Field<SizeType> Size;
+				Field<NodeIDType> NextNodeIndex;
+				Field<NodeIDType> PrevNodeIndex;
+				Field<uint16> RegionID;
+				NodeFlagReference<IsConst> IsPrevNodeAdjacent;
+				NodeFlagReference<IsConst> IsNextNodeAdjacent;
+				NodeFlagReference<IsConst> IsBlockFree;
+				NodeFlagReference<IsConst> IsPrimaryAllocated;
+			};
+
+			using Reference = NodeReference<false>;
+			using ConstReference = NodeReference<true>;
+
+			inline Reference at(NodeIDType NodeIndex) { return Reference(Nodes.at(NodeIndex), RegionsMemory); };
+			inline ConstReference at(NodeIDType NodeIndex) const { return ConstReference(Nodes.at(NodeIndex), RegionsMemory); };
+			inline Reference operator[](NodeIDType NodeIndex) { return Reference(Nodes[NodeIndex], RegionsMemory); };
+			inline ConstReference operator[](NodeIDType NodeIndex) const { return ConstReference(Nodes[NodeIndex], RegionsMemory); };
+
+			inline size_t size() const { return Nodes.size(); };
+			inline bool empty() const { return Nodes.empty(); };
+			inline void reserve(uint32 MaxAllocations) { Nodes.reserve(MaxAllocations); };
+			inline size_t capacity() const { return Nodes.capacity(); };
+			inline size_t GetMemorySize() const { return Nodes.GetMemorySize() + RegionsMemory.capacity() * sizeof(uint8*); };
+
+			void clear()
+			{
+				Nodes.clear();
+				RegionsMemory.clear();
+			};
+
+			void push_back(const NodeType& Node)
+			{
+				Nodes.push_back(NodeRecord{});
+				(*this)[(NodeIDType)Nodes.size() - 1] = Node;
+			};
+
+			void InsertRegion(const RegionType& Region, uint16 RegionID)
+			{
+				if (RegionID >= RegionsMemory.size())
+					RegionsMemory.resize(RegionID + 1, nullptr);
+				RegionsMemory[RegionID] = (uint8*)Region.Memory;
+			};
+
+			inline void RemoveRegion(const RegionType&, uint16 RegionID) { RegionsMemory.at(RegionID) = nullptr; };
+
+		private:
+			constexpr static uint8 PrevNodeAdjacentFlag = 1 << 0;
+			constexpr static uint8 NextNodeAdjacentFlag = 1 << 1;
+			constexpr static uint8 PrimaryAllocatedFlag = 1 << 2;
+			constexpr static uint8 FreeFlag = 1 << 3;
+
+			ChunkedArray<NodeRecord> Nodes{};
+			// Memory of regions, indexed by region ID
+			std::vector<uint8*> RegionsMemory{};
+		};
+
+		using PackedNodeStorage = BasicPackedNodeStorage<>;
+
+		// Walk through the list of nodes to find the node whose memory contains the address
+		template<typename NodeStorage>
+		inline typename NodeStorage::NodeIDType FindContainingNodeInList(const NodeStorage& Nodes, typename NodeStorage::NodeIDType HeadNodeIndex, const void* address)
+		{
+			for (typename NodeStorage::NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != NodeStorage::InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
+			{
+				typename NodeStorage::ConstReference Node = Nodes.at(nodeIndex);
+				if ((const uint8*)address >= (const uint8*)Node.NodeMemory && (const uint8*)address < (const uint8*)Node.NodeMemory + Node.Size)
+					return nodeIndex;
+			};
+			return NodeStorage::InvalidNodeID;
+		};
+
+		// ==================== FREE BLOCK INDEXES
+		// Free block index keeps track of free nodes and picks the node for a new allocation.
+		// Dynamic allocator notifies index with Insert when node becomes free(or free node gets a new size)
+		// and with Remove before free node is allocated, merged or its size is changed.
+		// Index also gives rules of carving regions into nodes, splitting and merging of nodes(see GeneralBlockRules).
+		// Trim releases memory which is not used after Clear, GetMemorySize returns bytes of memory held by the index.
+		// Index of other widths of sizes and node IDs is Rebind<SizeType, NodeIDType>.
+
+		// Rules of blocks with any size: region is one node, remainder of a node is split off when it's big enough,
+		// adjacent free nodes are always merged
+		struct GeneralBlockRules
+		{
+			// Returned pointers and sizes of blocks are multiples of granularity(regions are aligned by the allocator)
+			constexpr static uint32 Granularity = 1;
+			// Size of the block needed for the allocation of size bytes, 0 if the allocation is not possible
+			template<typename SizeType>
+			static inline SizeType RoundRequest(SizeType size) { return size; };
+			// Size of the region allocated for resize by size bytes
+			template<typename SizeType>
+			static inline SizeType RoundRegionSize(SizeType size) { return size; };
+			// Size of the next node carved from the remaining memory of a new region
+			template<typename SizeType>
+			static inline SizeType GetCarveSize(SizeType RemainingSize) { return RemainingSize; };
+			// Size which stays in the block after one split for the allocation of size bytes, BlockSize if the block is not split
+			template<typename SizeType>
+			static inline SizeType GetSplitSize(SizeType BlockSize, SizeType size) { return BlockSize > size && BlockSize - size >= MinAllocSizeRequirement ? size : BlockSize; };
+			// Can adjacent free nodes of the region be merged into one
+			template<typename NodeReference, typename RegionType>
+			static inline bool CanMerge(const NodeReference&, const NodeReference&, const RegionType&) { return true; };
+		};
+
+		// ==================== FIT POLICIES
+		// Fit policy decides which suitable free node is taken by scanning indexes(LinearScanIndex, ExplicitFreeListIndex).
+		// Search stops on the first node which is good enough for the policy,
+		// otherwise the smallest suitable node is taken.
+
+		// Smallest suitable node, stops early only on exact match
+		struct BestFit
+		{
+			constexpr static bool IsRoving = false;
+			template<typename SizeType>
+			static inline bool IsGoodEnough(SizeType CandidateSize, SizeType size) { return CandidateSize == size; };
+		};
+
+		// First suitable node from the start of the list
+		struct FirstFit
+		{
+			constexpr static bool IsRoving = false;
+			template<typename SizeType>
+			static inline bool IsGoodEnough(SizeType, SizeType) { return true; };
+		};
+
+		// First suitable node, search continues from the place where the previous one stopped(roving pointer)
+		struct NextFit
+		{
+			constexpr static bool IsRoving = true;
+			template<typename SizeType>
+			static inline bool IsGoodEnough(SizeType, SizeType) { return true; };
+		};
+
+		// Stops on the first node which wastes no more than MaxWaste bytes, otherwise smallest suitable node
+		template<uint32 MaxWaste>
+		struct GoodFit
+		{
+			constexpr static bool IsRoving = false;
+			template<typename SizeType>
+			static inline bool IsGoodEnough(SizeType CandidateSize, SizeType size) { return CandidateSize - size <= MaxWaste; };
+		};
+
+		// Search through the whole list of nodes, doesn't keep any state
+		template<typename FitPolicy = BestFit, typename SizeT = uint32, typename NodeIDT = uint32>
+		class LinearScanIndex : public GeneralBlockRules
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = LinearScanIndex<FitPolicy, OtherSizeType, OtherNodeIDType>;
+
+			static_assert(!FitPolicy::IsRoving, "LinearScanIndex doesn't keep a roving pointer, use ExplicitFreeListIndex for NextFit");
+
+			inline void Reserve(uint32) {};
+			inline void Trim() {};
+			inline size_t GetMemorySize() const { return 0; };
+			template<typename NodeStorage>
+			inline void Insert(NodeStorage&, NodeIDType) {};
+			template<typename NodeStorage>
+			inline void Remove(NodeStorage&, NodeIDType) {};
+			inline void Clear() {};
+
+			template<typename NodeStorage>
+			NodeIDType First(const NodeStorage& Nodes, NodeIDType HeadNodeIndex) const
+			{
+				for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
+				{
+					if (Nodes.at(nodeIndex).IsBlockFree == 1)
+						return nodeIndex;
+				};
+				return InvalidNodeID;
+			};
+
+			template<typename NodeStorage>
+			NodeIDType Find(const NodeStorage& Nodes, NodeIDType HeadNodeIndex, SizeType size)
+			{
+				// Loop through nodes by using indexes for the array
+				NodeIDType BestNodeIDForAllocation = InvalidNodeID;
+				for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
+				{
+					typename NodeStorage::ConstReference NodeCandidateHeader = Nodes.at(nodeIndex);
+					// Check if Node is suitable for allocation
+					if (NodeCandidateHeader.Size >= size && NodeCandidateHeader.IsBlockFree == 1)
+					{
+						if (FitPolicy::IsGoodEnough(NodeCandidateHeader.Size, size))
+							return nodeIndex;
+
+						// If a candidate is better than current BestNode, make the candidate The Best
+						if (BestNodeIDForAllocation == InvalidNodeID
+							|| Nodes.at(BestNodeIDForAllocation).Size > NodeCandidateHeader.Size)
+						{
+							BestNodeIDForAllocation = nodeIndex;
+						};
+					};
+				}
+				return BestNodeIDForAllocation;
+			};
+		};
+
+		// Search through an intrusive list of free nodes only(default),
+		// so search cost is proportional to the number of free nodes instead of all nodes
+		template<typename FitPolicy = BestFit, typename SizeT = uint32, typename NodeIDT = uint32>
+		class ExplicitFreeListIndex : public GeneralBlockRules
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = ExplicitFreeListIndex<FitPolicy, OtherSizeType, OtherNodeIDType>;
+
+			inline void Reserve(uint32 MaxAllocations) { Links.reserve(MaxAllocations); };
+			inline void Trim() { Links.shrink_to_fit(); };
+			inline size_t GetMemorySize() const { return Links.GetMemorySize(); };
+
+			template<typename NodeStorage>
+			void Insert(NodeStorage&, NodeIDType NodeIndex)
+			{
+				if (NodeIndex >= Links.size())
+					Links.resize(NodeIndex + 1);
+
+				Links[NodeIndex].Prev = InvalidNodeID;
+				Links[NodeIndex].Next = FreeListHead;
+				if (FreeListHead != InvalidNodeID)
+					Links[FreeListHead].Prev = NodeIndex;
+				FreeListHead = NodeIndex;
+			};
+
+			template<typename NodeStorage>
+			void Remove(NodeStorage&, NodeIDType NodeIndex)
+			{
+				FreeLinks& NodeLinks = Links.at(NodeIndex);
+				if (NodeLinks.Prev != InvalidNodeID)
+					Links[NodeLinks.Prev].Next = NodeLinks.Next;
+				else
+					FreeListHead = NodeLinks.Next;
+
+				if (NodeLinks.Next != InvalidNodeID)
+					Links[NodeLinks.Next].Prev = NodeLinks.Prev;
+
+				// Roving pointer moves to the next free node
+				if (Rover == NodeIndex)
+					Rover = NodeLinks.Next;
+
+				NodeLinks = FreeLinks{};
+			};
+
+			template<typename NodeStorage>
+			inline NodeIDType First(const NodeStorage&, NodeIDType) const { return FreeListHead; };
+
+			template<typename NodeStorage>
+			NodeIDType Find(const NodeStorage& Nodes, NodeIDType, SizeType size)
+			{
+				NodeIDType StartIndex = (FitPolicy::IsRoving && Rover != InvalidNodeID) ? Rover : FreeListHead;
+				NodeIDType BestNodeIDForAllocation = InvalidNodeID;
+
+				NodeIDType FoundIndex = Scan(Nodes, StartIndex, InvalidNodeID, size, BestNodeIDForAllocation);
+				// Wrap around to the nodes before the roving pointer
+				if (FoundIndex == InvalidNodeID && StartIndex != FreeListHead)
+					FoundIndex = Scan(Nodes, FreeListHead, StartIndex, size, BestNodeIDForAllocation);
+				if (FoundIndex == InvalidNodeID)
+					FoundIndex = BestNodeIDForAllocation;
+
+				if (FitPolicy::IsRoving)
+					Rover = FoundIndex;
+				return FoundIndex;
+			};
+
+			void Clear()
+			{
+				Links.clear();
+				FreeListHead = InvalidNodeID;
+				Rover = InvalidNodeID;
+			};
+
+		private:
+			struct FreeLinks
+			{
+				NodeIDType Prev = InvalidNodeID;
+				NodeIDType Next = InvalidNodeID;
+			};
+
+			// Scan free nodes in [FromIndex, ToIndex), return good enough node or track the best one
+			template<typename NodeStorage>
+			NodeIDType Scan(const NodeStorage& Nodes, NodeIDType FromIndex, NodeIDType ToIndex, SizeType size, NodeIDType& BestNodeIDForAllocation) const
+			{
+				for (NodeIDType nodeIndex = FromIndex; nodeIndex != ToIndex; nodeIndex = Links[nodeIndex].Next)
+				{
+					SizeType CandidateSize = Nodes.at(nodeIndex).Size;
+					if (CandidateSize >= size)
+					{
+						if (FitPolicy::IsGoodEnough(CandidateSize, size))
+							return nodeIndex;
+
+						if (BestNodeIDForAllocation == InvalidNodeID || Nodes.at(BestNodeIDForAllocation).Size > CandidateSize)
+							BestNodeIDForAllocation = nodeIndex;
+					}
+				}
+				return InvalidNodeID;
+			};
+
+			NodeIDType FreeListHead = InvalidNodeID;
+			// Roving pointer of NextFit policy
+			NodeIDType Rover = InvalidNodeID;
+			// Links of free nodes, indexed by node ID
+			ChunkedArray<FreeLinks> Links{};
+		};
+
+		// Two-level segregated fit(TLSF): free nodes are bucketed by size class,
+		// first level is power of two of the size, second level splits it into SecondLevelCount linear ranges.
+		// Bitmaps of non-empty buckets give constant time search of a suitable bucket.
+		// Search is not exact: when no bucket of a bigger class has nodes, only the first BucketScanLimit(8) nodes
+		// of the bucket of the size itself are checked, a fitting node beyond them is skipped and the allocator grows instead.
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicSegregatedFitIndex : public GeneralBlockRules
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicSegregatedFitIndex<OtherSizeType, OtherNodeIDType>;
+
+			constexpr static uint32 SecondLevelLog2 = 4;
+			constexpr static uint32 SecondLevelCount = 1 << SecondLevelLog2;
+			constexpr static uint32 FirstLevelCount = sizeof(SizeType) * 8;
+			// Max count of nodes checked in the bucket of the size itself, when no bucket of bigger class has nodes
+			constexpr static uint32 BucketScanLimit = 8;
+
+			BasicSegregatedFitIndex()
+			{
+				Clear();
+			};
+
+			inline void Reserve(uint32 MaxAllocations) { Links.reserve(MaxAllocations); };
+			inline void Trim() { Links.shrink_to_fit(); };
+			inline size_t GetMemorySize() const { return Links.GetMemorySize(); };
+
+			template<typename NodeStorage>
+			void Insert(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				if (NodeIndex >= Links.size())
+					Links.resize(NodeIndex + 1);
+
+				uint32 FirstLevel = 0, SecondLevel = 0;
+				MapSize(Nodes.at(NodeIndex).Size, FirstLevel, SecondLevel);
+
+				NodeIDType& BucketHead = Buckets[FirstLevel][SecondLevel];
+				Links[NodeIndex].Prev = InvalidNodeID;
+				Links[NodeIndex].Next = BucketHead;
+				if (BucketHead != InvalidNodeID)
+					Links[BucketHead].Prev = NodeIndex;
+				BucketHead = NodeIndex;
+
+				FirstLevelBitmap |= (SizeType)1 << FirstLevel;
+				SecondLevelBitmaps[FirstLevel] |= 1u << SecondLevel;
+			};
+
+			template<typename NodeStorage>
+			void Remove(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				uint32 FirstLevel = 0, SecondLevel = 0;
+				MapSize(Nodes.at(NodeIndex).Size, FirstLevel, SecondLevel);
+
+				FreeLinks& NodeLinks = Links.at(NodeIndex);
+				if (NodeLinks.Prev != InvalidNodeID)
+					Links[NodeLinks.Prev].Next = NodeLinks.Next;
+				else
+					Buckets[FirstLevel][SecondLevel] = NodeLinks.Next;
+
+				if (NodeLinks.Next != InvalidNodeID)
+					Links[NodeLinks.Next].Prev = NodeLinks.Prev;
+
+				NodeLinks = FreeLinks{};
+
+				// Unmark empty bucket
+				if (Buckets[FirstLevel][SecondLevel] == InvalidNodeID)
+				{
+					SecondLevelBitmaps[FirstLevel] &= ~(1u << SecondLevel);
+					if (SecondLevelBitmaps[FirstLevel] == 0)
+						FirstLevelBitmap &= ~((SizeType)1 << FirstLevel);
+				}
+			};
+
+			template<typename NodeStorage>
+			NodeIDType Find(const NodeStorage& Nodes, NodeIDType, SizeType size)
+			{
+				uint32 FirstLevel = 0, SecondLevel = 0;
+				// Round the size up to the next size class, so any node from found bucket is suitable
+				SizeType RoundedSize = size;
+				uint32 SizeFirstLevel = FindHighestSetBit(size);
+				if (SizeFirstLevel >= SecondLevelLog2)
+					RoundedSize += ((SizeType)1 << (SizeFirstLevel - SecondLevelLog2)) - 1;
+
+				// Rounded size wraps when it doesn't fit into the size type
+				if (RoundedSize >= size)
+				{
+					MapSize(RoundedSize, FirstLevel, SecondLevel);
+
+					uint32 SecondLevelMap = SecondLevelBitmaps[FirstLevel] & (~0u << SecondLevel);
+					if (SecondLevelMap == 0)
+					{
+						SizeType FirstLevelMap = FirstLevel + 1 < FirstLevelCount ? FirstLevelBitmap & (~(SizeType)0 << (FirstLevel + 1)) : 0;
+						if (FirstLevelMap != 0)
+						{
+							FirstLevel = FindLowestSetBit(FirstLevelMap);
+							SecondLevelMap = SecondLevelBitmaps[FirstLevel];
+						}
+					}
+
+					if (SecondLevelMap != 0)
+						return Buckets[FirstLevel][FindLowestSetBit(SecondLevelMap)];
+				}
+
+				// Rounding skips nodes from the bucket of the size itself, check a few of them before the allocator grows,
+				// the scan is bounded to keep search constant time
+				MapSize(size, FirstLevel, SecondLevel);
+				uint32 ScannedCount = 0;
+				for (NodeIDType nodeIndex = Buckets[FirstLevel][SecondLevel]; nodeIndex != InvalidNodeID && ScannedCount < BucketScanLimit; nodeIndex = Links[nodeIndex].Next, ScannedCount++)
+				{
+					if (Nodes.at(nodeIndex).Size >= size)
+						return nodeIndex;
+				}
+				return InvalidNodeID;
+			};
+
+			template<typename NodeStorage>
+			NodeIDType First(const NodeStorage&, NodeIDType) const
+			{
+				if (FirstLevelBitmap == 0)
+					return InvalidNodeID;
+				uint32 FirstLevel = FindLowestSetBit(FirstLevelBitmap);
+				return Buckets[FirstLevel][FindLowestSetBit(SecondLevelBitmaps[FirstLevel])];
+			};
+
+			void Clear()
+			{
+				Links.clear();
+				FirstLevelBitmap = 0;
+				for (uint32 FirstLevel = 0; FirstLevel < FirstLevelCount; FirstLevel++)
+				{
+					SecondLevelBitmaps[FirstLevel] = 0;
+					for (uint32 SecondLevel = 0; SecondLevel < SecondLevelCount; SecondLevel++)
+						Buckets[FirstLevel][SecondLevel] = InvalidNodeID;
+				}
+			};
+
+		private:
+			struct FreeLinks
+			{
+				NodeIDType Prev = InvalidNodeID;
+				NodeIDType Next = InvalidNodeID;
+			};
+
+			static inline void MapSize(SizeType size, uint32& FirstLevel, uint32& SecondLevel)
+			{
+				FirstLevel = FindHighestSetBit(size);
+				if (FirstLevel < SecondLevelLog2)
+					SecondLevel = (uint32)(size << (SecondLevelLog2 - FirstLevel)) ^ SecondLevelCount;
+				else
+					SecondLevel = (uint32)(size >> (FirstLevel - SecondLevelLog2)) ^ SecondLevelCount;
+			};
+
+			SizeType FirstLevelBitmap = 0;
+			uint32 SecondLevelBitmaps[FirstLevelCount];
+			NodeIDType Buckets[FirstLevelCount][SecondLevelCount];
+			// Links of free nodes in their buckets, indexed by node ID
+			ChunkedArray<FreeLinks> Links{};
+		};
+
+		using SegregatedFitIndex = BasicSegregatedFitIndex<>;
+
+		// Red-black tree of free nodes ordered by (Size, address), gives exact best-fit with logarithmic search/insert/remove.
+		// Tree links live in a side array indexed by node ID
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicSizeOrderedTreeIndex : public GeneralBlockRules
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicSizeOrderedTreeIndex<OtherSizeType, OtherNodeIDType>;
+
+			inline void Reserve(uint32 MaxAllocations) { Links.reserve(MaxAllocations); };
+			inline void Trim() { Links.shrink_to_fit(); };
+			inline size_t GetMemorySize() const { return Links.GetMemorySize(); };
+
+			template<typename NodeStorage>
+			void Insert(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				if (NodeIndex >= Links.size())
+					Links.resize(NodeIndex + 1);
+
+				NodeIDType ParentIndex = InvalidNodeID;
+				bool IsLeftChild = false;
+				for (NodeIDType CurrentIndex = Root; CurrentIndex != InvalidNodeID;)
+				{
+					ParentIndex = CurrentIndex;
+					IsLeftChild = IsLess(Nodes, NodeIndex, CurrentIndex);
+					CurrentIndex = IsLeftChild ? Links[CurrentIndex].Left : Links[CurrentIndex].Right;
+				}
+
+				TreeLinks& NodeLinks = Links[NodeIndex];
+				NodeLinks = TreeLinks{};
+				NodeLinks.Parent = ParentIndex;
+				NodeLinks.IsRed = 1;
+				if (ParentIndex == InvalidNodeID)
+					Root = NodeIndex;
+				else if (IsLeftChild)
+					Links[ParentIndex].Left = NodeIndex;
+				else
+					Links[ParentIndex].Right = NodeIndex;
+
+				FixupAfterInsert(NodeIndex);
+			};
+
+			template<typename NodeStorage>
+			void Remove(NodeStorage&, NodeIDType NodeIndex)
+			{
+				NodeIDType RemovedIndex = NodeIndex;
+				bool IsRemovedColorRed = IsRed(RemovedIndex);
+				NodeIDType ReplacementIndex = InvalidNodeID;
+				NodeIDType ReplacementParentIndex = InvalidNodeID;
+
+				if (Links[NodeIndex].Left == InvalidNodeID)
+				{
+					ReplacementIndex = Links[NodeIndex].Right;
+					ReplacementParentIndex = Links[NodeIndex].Parent;
+					Transplant(NodeIndex, ReplacementIndex);
+				}
+				else if (Links[NodeIndex].Right == InvalidNodeID)
+				{
+					ReplacementIndex = Links[NodeIndex].Left;
+					ReplacementParentIndex = Links[NodeIndex].Parent;
+					Transplant(NodeIndex, ReplacementIndex);
+				}
+				else
+				{
+					// Node with both children is replaced by its successor
+					RemovedIndex = Minimum(Links[NodeIndex].Right);
+					IsRemovedColorRed = IsRed(RemovedIndex);
+					ReplacementIndex = Links[RemovedIndex].Right;
+					if (Links[RemovedIndex].Parent == NodeIndex)
+					{
+						ReplacementParentIndex = RemovedIndex;
+					}
+					else
+					{
+						ReplacementParentIndex = Links[RemovedIndex].Parent;
+						Transplant(RemovedIndex, ReplacementIndex);
+						Links[RemovedIndex].Right = Links[NodeIndex].Right;
+						Links[Links[RemovedIndex].Right].Parent = RemovedIndex;
+					}
+					Transplant(NodeIndex, RemovedIndex);
+					Links[RemovedIndex].Left = Links[NodeIndex].Left;
+					Links[Links[RemovedIndex].Left].Parent = RemovedIndex;
+					Links[RemovedIndex].IsRed = Links[NodeIndex].IsRed;
+				}
+
+				Links[NodeIndex] = TreeLinks{};
+
+				if (!IsRemovedColorRed)
+					FixupAfterRemove(ReplacementIndex, ReplacementParentIndex);
+			};
+
+			template<typename NodeStorage>
+			NodeIDType Find(const NodeStorage& Nodes, NodeIDType, SizeType size)
+			{
+				// Leftmost node with enough size is the smallest suitable node with the lowest address
+				NodeIDType BestNodeIDForAllocation = InvalidNodeID;
+				for (NodeIDType CurrentIndex = Root; CurrentIndex != InvalidNodeID;)
+				{
+					if (Nodes.at(CurrentIndex).Size >= size)
+					{
+						BestNodeIDForAllocation = CurrentIndex;
+						CurrentIndex = Links[CurrentIndex].Left;
+					}
+					else
+					{
+						CurrentIndex = Links[CurrentIndex].Right;
+					}
+				}
+				return BestNodeIDForAllocation;
+			};
+
+			template<typename NodeStorage>
+			inline NodeIDType First(const NodeStorage&, NodeIDType) const
+			{
+				return Root != InvalidNodeID ? Minimum(Root) : InvalidNodeID;
+			};
+
+			void Clear()
+			{
+				Links.clear();
+				Root = InvalidNodeID;
+			};
+
+		private:
+			struct TreeLinks
+			{
+				NodeIDType Parent = InvalidNodeID;
+				NodeIDType Left = InvalidNodeID;
+				NodeIDType Right = InvalidNodeID;
+				uint8 IsRed = 0;
+			};
+
+			template<typename NodeStorage>
+			static inline bool IsLess(const NodeStorage& Nodes, NodeIDType FirstIndex, NodeIDType SecondIndex)
+			{
+				typename NodeStorage::ConstReference First = Nodes.at(FirstIndex);
+				typename NodeStorage::ConstReference Second = Nodes.at(SecondIndex);
+				if (First.Size != Second.Size)
+					return First.Size < Second.Size;
+				return (uint8*)First.NodeMemory < (uint8*)Second.NodeMemory;
+			};
+
+			inline bool IsRed(NodeIDType NodeIndex) const
+			{
+				return NodeIndex != InvalidNodeID && Links[NodeIndex].IsRed == 1;
+			};
+
+			inline NodeIDType Minimum(NodeIDType NodeIndex) const
+			{
+				while (Links[NodeIndex].Left != InvalidNodeID)
+					NodeIndex = Links[NodeIndex].Left;
+				return NodeIndex;
+			};
+
+			// Put the subtree of NewIndex in place of the subtree of OldIndex
+			void Transplant(NodeIDType OldIndex, NodeIDType NewIndex)
+			{
+				NodeIDType ParentIndex = Links[OldIndex].Parent;
+				if (ParentIndex == InvalidNodeID)
+					Root = NewIndex;
+				else if (Links[ParentIndex].Left == OldIndex)
+					Links[ParentIndex].Left = NewIndex;
+				else
+					Links[ParentIndex].Right = NewIndex;
+
+				if (NewIndex != InvalidNodeID)
+					Links[NewIndex].Parent = ParentIndex;
+			};
+
+			void RotateLeft(NodeIDType NodeIndex)
+			{
+				NodeIDType ChildIndex = Links[NodeIndex].Right;
+				Links[NodeIndex].Right = Links[ChildIndex].Left;
+				if (Links[ChildIndex].Left != InvalidNodeID)
+					Links[Links[ChildIndex].Left].Parent = NodeIndex;
+				Transplant(NodeIndex, ChildIndex);
+				Links[ChildIndex].Left = NodeIndex;
+				Links[NodeIndex].Parent = ChildIndex;
+			};
+
+			void RotateRight(NodeIDType NodeIndex)
+			{
+				NodeIDType ChildIndex = Links[NodeIndex].Left;
+				Links[NodeIndex].Left = Links[ChildIndex].Right;
+				if (Links[ChildIndex].Right != InvalidNodeID)
+					Links[Links[ChildIndex].Right].Parent = NodeIndex;
+				Transplant(NodeIndex, ChildIndex);
+				Links[ChildIndex].Right = NodeIndex;
+				Links[NodeIndex].Parent = ChildIndex;
+			};
+
+			void FixupAfterInsert(NodeIDType NodeIndex)
+			{
+				while (NodeIndex != Root && IsRed(Links[NodeIndex].Parent))
+				{
+					NodeIDType ParentIndex = Links[NodeIndex].Parent;
+					NodeIDType GrandParentIndex = Links[ParentIndex].Parent;
+					bool IsParentLeftChild = Links[GrandParentIndex].Left == ParentIndex;
+					NodeIDType UncleIndex = IsParentLeftChild ? Links[GrandParentIndex].Right : Links[GrandParentIndex].Left;
+
+					if (IsRed(UncleIndex))
+					{
+						Links[ParentIndex].IsRed = 0;
+						Links[UncleIndex].IsRed = 0;
+						Links[GrandParentIndex].IsRed = 1;
+						NodeIndex = GrandParentIndex;
+						continue;
+					}
+
+					if (IsParentLeftChild)
+					{
+						if (Links[ParentIndex].Right == NodeIndex)
+						{
+							RotateLeft(ParentIndex);
+							ParentIndex = NodeIndex;
+						}
+						Links[ParentIndex].IsRed = 0;
+						Links[GrandParentIndex].IsRed = 1;
+						RotateRight(GrandParentIndex);
+					}
+					else
+					{
+						if (Links[ParentIndex].Left == NodeIndex)
+						{
+							RotateRight(ParentIndex);
+							ParentIndex = NodeIndex;
+						}
+						Links[ParentIndex].IsRed = 0;
+						Links[GrandParentIndex].IsRed = 1;
+						RotateLeft(GrandParentIndex);
+					}
+					break;
+				}
+				Links[Root].IsRed = 0;
+			};
+
+			void FixupAfterRemove(NodeIDType NodeIndex, NodeIDType ParentIndex)
+			{
+				while (NodeIndex != Root && !IsRed(NodeIndex))
+				{
+					if (Links[ParentIndex].Left == NodeIndex)
+					{
+						NodeIDType SiblingIndex = Links[ParentIndex].Right;
+						if (IsRed(SiblingIndex))
+						{
+							Links[SiblingIndex].IsRed = 0;
+							Links[ParentIndex].IsRed = 1;
+							RotateLeft(ParentIndex);
+							SiblingIndex = Links[ParentIndex].Right;
+						}
+						if (!IsRed(Links[SiblingIndex].Left) && !IsRed(Links[SiblingIndex].Right))
+						{
+							Links[SiblingIndex].IsRed = 1;
+							NodeIndex = ParentIndex;
+							ParentIndex = Links[NodeIndex].Parent;
+							continue;
+						}
+						if (!IsRed(Links[SiblingIndex].Right))
+						{
+							Links[Links[SiblingIndex].Left].IsRed = 0;
+							Links[SiblingIndex].IsRed = 1;
+							RotateRight(SiblingIndex);
+							SiblingIndex = Links[ParentIndex].Right;
+						}
+						Links[SiblingIndex].IsRed = Links[ParentIndex].IsRed;
+						Links[ParentIndex].IsRed = 0;
+						Links[Links[SiblingIndex].Right].IsRed = 0;
+						RotateLeft(ParentIndex);
+					}
+					else
+					{
+						NodeIDType SiblingIndex = Links[ParentIndex].Left;
+						if (IsRed(SiblingIndex))
+						{
+							Links[SiblingIndex].IsRed = 0;
+							Links[ParentIndex].IsRed = 1;
+							RotateRight(ParentIndex);
+							SiblingIndex = Links[ParentIndex].Left;
+						}
+						if (!IsRed(Links[SiblingIndex].Left) && !IsRed(Links[SiblingIndex].Right))
+						{
+							Links[SiblingIndex].IsRed = 1;
+							NodeIndex = ParentIndex;
+							ParentIndex = Links[NodeIndex].Parent;
+							continue;
+						}
+						if (!IsRed(Links[SiblingIndex].Left))
+						{
+							Links[Links[SiblingIndex].Right].IsRed = 0;
+							Links[SiblingIndex].IsRed = 1;
+							RotateLeft(SiblingIndex);
+							SiblingIndex = Links[ParentIndex].Left;
+						}
+						Links[SiblingIndex].IsRed = Links[ParentIndex].IsRed;
+						Links[ParentIndex].IsRed = 0;
+						Links[Links[SiblingIndex].Left].IsRed = 0;
+						RotateRight(ParentIndex);
+					}
+					NodeIndex = Root;
+				}
+				if (NodeIndex != InvalidNodeID)
+					Links[NodeIndex].IsRed = 0;
+			};
+
+			NodeIDType Root = InvalidNodeID;
+			ChunkedArray<TreeLinks> Links{};
+		};
+
+		using SizeOrderedTreeIndex = BasicSizeOrderedTreeIndex<>;
+
+		// Binary buddy system: every region is carved into power of two blocks(aligned to their size from the start of the region),
+		// allocation takes the smallest free block of enough order and halves it down to the rounded request,
+		// freed block is merged with its buddy while the buddy is free and has the same size.
+		// Buddy is found from the node itself(size and offset in the region), free blocks are kept in a list per order,
+		// bitmap of non-empty orders gives constant time search
+		template<uint32 MinBlockLog2 = 8, typename SizeT = uint32, typename NodeIDT = uint32>
+		class BuddyIndex
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BuddyIndex<MinBlockLog2, OtherSizeType, OtherNodeIDType>;
+
+			constexpr static uint32 Granularity = 1;
+			constexpr static uint32 OrderCount = sizeof(SizeType) * 8;
+			static_assert(MinBlockLog2 < OrderCount, "Minimal block must fit into the size type");
+			constexpr static SizeType MinBlockSize = (SizeType)1 << MinBlockLog2;
+
+			BuddyIndex()
+			{
+				Clear();
+			};
+
+			static inline SizeType RoundRequest(SizeType size)
+			{
+				if (size <= MinBlockSize)
+					return MinBlockSize;
+				if (size > ((SizeType)1 << (OrderCount - 1)))
+					return 0;
+				return (SizeType)1 << (FindHighestSetBit(size - 1) + 1);
+			};
+
+			static inline SizeType RoundRegionSize(SizeType size)
+			{
+				SizeType RoundedSize = (size + MinBlockSize - 1) & ~(MinBlockSize - 1);
+				return RoundedSize >= size ? RoundedSize : size & ~(MinBlockSize - 1);
+			};
+
+			static inline SizeType GetCarveSize(SizeType RemainingSize) { return (SizeType)1 << FindHighestSetBit(RemainingSize); };
+
+			static inline SizeType GetSplitSize(SizeType BlockSize, SizeType size) { return BlockSize / 2 >= size ? BlockSize / 2 : BlockSize; };
+
+			template<typename NodeReference>
+			static inline bool CanMerge(const NodeReference& Left, const NodeReference& Right, const RegionType& Region)
+			{
+				unsigned long long Offset = (unsigned long long)((uint8*)Left.NodeMemory - (uint8*)Region.Memory);
+				return Left.Size == Right.Size && (Offset & (2ull * Left.Size - 1)) == 0;
+			};
+
+			inline void Reserve(uint32 MaxAllocations) { Links.reserve(MaxAllocations); };
+			inline void Trim() { Links.shrink_to_fit(); };
+			inline size_t GetMemorySize() const { return Links.GetMemorySize(); };
+
+			template<typename NodeStorage>
+			void Insert(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				if (NodeIndex >= Links.size())
+					Links.resize(NodeIndex + 1);
+
+				uint32 Order = FindHighestSetBit(Nodes.at(NodeIndex).Size);
+				DYNAMIC_ALLOCATOR_ASSERT(Nodes.at(NodeIndex).Size == (SizeType)1 << Order && "Buddy block size must be a power of two");
+
+				Links[NodeIndex].Prev = InvalidNodeID;
+				Links[NodeIndex].Next = OrderHeads[Order];
+				if (OrderHeads[Order] != InvalidNodeID)
+					Links[OrderHeads[Order]].Prev = NodeIndex;
+				OrderHeads[Order] = NodeIndex;
+				OrderBitmap |= (SizeType)1 << Order;
+			};
+
+			template<typename NodeStorage>
+			void Remove(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				uint32 Order = FindHighestSetBit(Nodes.at(NodeIndex).Size);
+
+				FreeLinks& NodeLinks = Links.at(NodeIndex);
+				if (NodeLinks.Prev != InvalidNodeID)
+					Links[NodeLinks.Prev].Next = NodeLinks.Next;
+				else
+					OrderHeads[Order] = NodeLinks.Next;
+
+				if (NodeLinks.Next != InvalidNodeID)
+					Links[NodeLinks.Next].Prev = NodeLinks.Prev;
+
+				NodeLinks = FreeLinks{};
+
+				if (OrderHeads[Order] == InvalidNodeID)
+					OrderBitmap &= ~((SizeType)1 << Order);
+			};
+
+			template<typename NodeStorage>
+			NodeIDType Find(const NodeStorage&, NodeIDType, SizeType size)
+			{
+				uint32 Order = FindHighestSetBit(size);
+				if (size != (SizeType)1 << Order)
+				{
+					if (Order + 1 >= OrderCount)
+						return InvalidNodeID;
+					Order++;
+				}
+
+				SizeType OrderMap = OrderBitmap & (~(SizeType)0 << Order);
+				return OrderMap != 0 ? OrderHeads[FindLowestSetBit(OrderMap)] : InvalidNodeID;
+			};
+
+			template<typename NodeStorage>
+			NodeIDType First(const NodeStorage&, NodeIDType) const
+			{
+				return OrderBitmap != 0 ? OrderHeads[FindLowestSetBit(OrderBitmap)] : InvalidNodeID;
+			};
+
+			void Clear()
+			{
+				Links.clear();
+				OrderBitmap = 0;
+				for (uint32 Order = 0; Order < OrderCount; Order++)
+					OrderHeads[Order] = InvalidNodeID;
+			};
+
+		private:
+			struct FreeLinks
+			{
+				NodeIDType Prev = InvalidNodeID;
+				NodeIDType Next = InvalidNodeID;
+			};
+
+			SizeType OrderBitmap = 0;
+			NodeIDType OrderHeads[OrderCount];
+			// Links of free blocks in the lists of their orders, indexed by node ID
+			ChunkedArray<FreeLinks> Links{};
+		};
+
+		// ==================== SEARCH KERNELS
+		// Kernels scan contiguous arrays of node sizes and free flags(SoANodeStorage), dead nodes have zero size and never fit.
+		// Best fit is the smallest free size which is not less than the requested one, the lowest node ID wins on equal sizes.
+		// Vector kernels reduce a block of nodes to its minimal suitable size and rescan the block only if it has a better node.
+
+		constexpr static uint32 BestFitKernelBlockSize = 64;
+
+		// Scan nodes in [Begin, End), update the best node, return true on exact match
+		inline bool ScanBestFit(const uint32* Sizes, const uint8* FreeFlags, uint32 Begin, uint32 End, uint32 size, uint32& BestSize, uint32& BestNodeIndex)
+		{
+			for (uint32 nodeIndex = Begin; nodeIndex < End; nodeIndex++)
+			{
+				uint32 CandidateSize = Sizes[nodeIndex];
+				if (FreeFlags[nodeIndex] != 0 && CandidateSize >= size && CandidateSize < BestSize)
+				{
+					BestSize = CandidateSize;
+					BestNodeIndex = nodeIndex;
+					if (CandidateSize == size)
+						return true;
+				}
+			}
+			return false;
+		};
+
+#if defined(DYNAMIC_ALLOCATOR_AVX2)
+		// 16 sizes per iteration: two 8-lane unsigned compares and min-reductions
+		inline uint32 FindBestFitAVX2(const uint32* Sizes, const uint8* FreeFlags, uint32 Count, uint32 size)
+		{
+			const __m256i Request = _mm256_set1_epi32((int)size);
+			const __m256i Zero = _mm256_setzero_si256();
+			const __m256i NoCandidate = _mm256_set1_epi32(-1);
+
+			uint32 BestSize = ~0u;
+			uint32 BestNodeIndex = InvalidNodeID;
+			uint32 BlockStart = 0;
+			for (; BlockStart + BestFitKernelBlockSize <= Count; BlockStart += BestFitKernelBlockSize)
+			{
+				__m256i Min = NoCandidate;
+				for (uint32 nodeIndex = BlockStart; nodeIndex < BlockStart + BestFitKernelBlockSize; nodeIndex += 16)
+				{
+					__m256i SizesLow = _mm256_loadu_si256((const __m256i*)(Sizes + nodeIndex));
+					__m256i SizesHigh = _mm256_loadu_si256((const __m256i*)(Sizes + nodeIndex + 8));
+					__m256i FreeLow = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(FreeFlags + nodeIndex)));
+					__m256i FreeHigh = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(FreeFlags + nodeIndex + 8)));
+
+					// Size fits if max(size, request) == size, lane is a candidate if it fits and is not occupied
+					__m256i FitsLow = _mm256_andnot_si256(_mm256_cmpeq_epi32(FreeLow, Zero), _mm256_cmpeq_epi32(_mm256_max_epu32(SizesLow, Request), SizesLow));
+					__m256i FitsHigh = _mm256_andnot_si256(_mm256_cmpeq_epi32(FreeHigh, Zero), _mm256_cmpeq_epi32(_mm256_max_epu32(SizesHigh, Request), SizesHigh));
+					Min = _mm256_min_epu32(Min, _mm256_blendv_epi8(NoCandidate, SizesLow, FitsLow));
+					Min = _mm256_min_epu32(Min, _mm256_blendv_epi8(NoCandidate, SizesHigh, FitsHigh));
+				}
+
+				__m128i Min4 = _mm_min_epu32(_mm256_castsi256_si128(Min), _mm256_extracti128_si256(Min, 1));
+				Min4 = _mm_min_epu32(Min4, _mm_shuffle_epi32(Min4, 0x4E));
+				Min4 = _mm_min_epu32(Min4, _mm_shuffle_epi32(Min4, 0xB1));
+				if ((uint32)_mm_cvtsi128_si32(Min4) < BestSize &&
+					ScanBestFit(Sizes, FreeFlags, BlockStart, BlockStart + BestFitKernelBlockSize, size, BestSize, BestNodeIndex))
+					return BestNodeIndex;
+			}
+			ScanBestFit(Sizes, FreeFlags, BlockStart, Count, size, BestSize, BestNodeIndex);
+			return BestNodeIndex;
+		};
+#endif
+
+#if defined(DYNAMIC_ALLOCATOR_SSE41)
+		// 8 sizes per iteration: two 4-lane unsigned compares and min-reductions
+		inline uint32 FindBestFitSSE41(const uint32* Sizes, const uint8* FreeFlags, uint32 Count, uint32 size)
+		{
+			const __m128i Request = _mm_set1_epi32((int)size);
+			const __m128i Zero = _mm_setzero_si128();
+			const __m128i NoCandidate = _mm_set1_epi32(-1);
+
+			uint32 BestSize = ~0u;
+			uint32 BestNodeIndex = InvalidNodeID;
+			uint32 BlockStart = 0;
+			for (; BlockStart + BestFitKernelBlockSize <= Count; BlockStart += BestFitKernelBlockSize)
+			{
+				__m128i Min = NoCandidate;
+				for (uint32 nodeIndex = BlockStart; nodeIndex < BlockStart + BestFitKernelBlockSize; nodeIndex += 8)
+				{
+					__m128i SizesLow = _mm_loadu_si128((const __m128i*)(Sizes + nodeIndex));
+					__m128i SizesHigh = _mm_loadu_si128((const __m128i*)(Sizes + nodeIndex + 4));
+					__m128i Free = _mm_loadl_epi64((const __m128i*)(FreeFlags + nodeIndex));
+					__m128i FreeLow = _mm_cvtepu8_epi32(Free);
+					__m128i FreeHigh = _mm_cvtepu8_epi32(_mm_srli_si128(Free, 4));
+
+					__m128i FitsLow = _mm_andnot_si128(_mm_cmpeq_epi32(FreeLow, Zero), _mm_cmpeq_epi32(_mm_max_epu32(SizesLow, Request), SizesLow));
+					__m128i FitsHigh = _mm_andnot_si128(_mm_cmpeq_epi32(FreeHigh, Zero), _mm_cmpeq_epi32(_mm_max_epu32(SizesHigh, Request), SizesHigh));
+					Min = _mm_min_epu32(Min, _mm_blendv_epi8(NoCandidate, SizesLow, FitsLow));
+					Min = _mm_min_epu32(Min, _mm_blendv_epi8(NoCandidate, SizesHigh, FitsHigh));
+				}
+
+				Min = _mm_min_epu32(Min, _mm_shuffle_epi32(Min, 0x4E));
+				Min = _mm_min_epu32(Min, _mm_shuffle_epi32(Min, 0xB1));
+				if ((uint32)_mm_cvtsi128_si32(Min) < BestSize &&
+					ScanBestFit(Sizes, FreeFlags, BlockStart, BlockStart + BestFitKernelBlockSize, size, BestSize, BestNodeIndex))
+					return BestNodeIndex;
+			}
+			ScanBestFit(Sizes, FreeFlags, BlockStart, Count, size, BestSize, BestNodeIndex);
+			return BestNodeIndex;
+		};
+#endif
+
+		inline uint32 FindBestFitScalar(const uint32* Sizes, const uint8* FreeFlags, uint32 Count, uint32 size)
+		{
+			uint32 BestSize = ~0u;
+			uint32 BestNodeIndex = InvalidNodeID;
+			ScanBestFit(Sizes, FreeFlags, 0, Count, size, BestSize, BestNodeIndex);
+			return BestNodeIndex;
+		};
+
+		// Best fit with the widest kernel available for the target
+		inline uint32 FindBestFit(const uint32* Sizes, const uint8* FreeFlags, uint32 Count, uint32 size)
+		{
+#if defined(DYNAMIC_ALLOCATOR_AVX2)
+			return FindBestFitAVX2(Sizes, FreeFlags, Count, size);
+#elif defined(DYNAMIC_ALLOCATOR_SSE41)
+			return FindBestFitSSE41(Sizes, FreeFlags, Count, size);
+#else
+			return FindBestFitScalar(Sizes, FreeFlags, Count, size);
+#endif
+		};
+
+		// Pointer match: the first node in [0, Count) whose memory starts at the address
+		inline uint32 FindPointerScalar(void* const* Pointers, uint32 Count, const void* address)
+		{
+			for (uint32 nodeIndex = 0; nodeIndex < Count; nodeIndex++)
+			{
+				if (Pointers[nodeIndex] == address)
+					return nodeIndex;
+			}
+			return InvalidNodeID;
+		};
+
+		// Vector pointer match kernels are implemented for 64-bit pointers
+#if defined(DYNAMIC_ALLOCATOR_AVX2) && UINTPTR_MAX == 0xFFFFFFFFFFFFFFFFu
+		// 8 pointers per iteration: two 4-lane 64-bit compares
+		inline uint32 FindPointerAVX2(void* const* Pointers, uint32 Count, const void* address)
+		{
+			const __m256i Address = _mm256_set1_epi64x((long long)(uintptr_t)address);
+			uint32 nodeIndex = 0;
+			for (; nodeIndex + 8 <= Count; nodeIndex += 8)
+			{
+				__m256i MatchLow = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(Pointers + nodeIndex)), Address);
+				__m256i MatchHigh = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(Pointers + nodeIndex + 4)), Address);
+				uint32 MatchMask = (uint32)_mm256_movemask_pd(_mm256_castsi256_pd(MatchLow)) | ((uint32)_mm256_movemask_pd(_mm256_castsi256_pd(MatchHigh)) << 4);
+				if (MatchMask != 0)
+					return nodeIndex + FindLowestSetBit(MatchMask);
+			}
+			uint32 TailIndex = FindPointerScalar(Pointers + nodeIndex, Count - nodeIndex, address);
+			return TailIndex != InvalidNodeID ? nodeIndex + TailIndex : InvalidNodeID;
+		};
+#endif
+
+#if defined(DYNAMIC_ALLOCATOR_SSE41) && UINTPTR_MAX == 0xFFFFFFFFFFFFFFFFu
+		// 4 pointers per iteration: two 2-lane 64-bit compares
+		inline uint32 FindPointerSSE41(void* const* Pointers, uint32 Count, const void* address)
+		{
+			const __m128i Address = _mm_set1_epi64x((long long)(uintptr_t)address);
+			uint32 nodeIndex = 0;
+			for (; nodeIndex + 4 <= Count; nodeIndex += 4)
+			{
+				__m128i MatchLow = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i*)(Pointers + nodeIndex)), Address);
+				__m128i MatchHigh = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i*)(Pointers + nodeIndex + 2)), Address);
+				uint32 MatchMask = (uint32)_mm_movemask_pd(_mm_castsi128_pd(MatchLow)) | ((uint32)_mm_movemask_pd(_mm_castsi128_pd(MatchHigh)) << 2);
+				if (MatchMask != 0)
+					return nodeIndex + FindLowestSetBit(MatchMask);
+			}
+			uint32 TailIndex = FindPointerScalar(Pointers + nodeIndex, Count - nodeIndex, address);
+			return TailIndex != InvalidNodeID ? nodeIndex + TailIndex : InvalidNodeID;
+		};
+#endif
+
+		// Pointer match with the widest kernel available for the target
+		inline uint32 FindPointer(void* const* Pointers, uint32 Count, const void* address)
+		{
+#if defined(DYNAMIC_ALLOCATOR_AVX2) && UINTPTR_MAX == 0xFFFFFFFFFFFFFFFFu
+			return FindPointerAVX2(Pointers, Count, address);
+#elif defined(DYNAMIC_ALLOCATOR_SSE41) && UINTPTR_MAX == 0xFFFFFFFFFFFFFFFFu
+			return FindPointerSSE41(Pointers, Count, address);
+#else
+			return FindPointerScalar(Pointers, Count, address);
+#endif
+		};
+
+		// Exact best fit over the arrays of all node sizes and free flags by the best fit kernel, requires SoANodeStorage.
+		// Doesn't keep any state, search touches 5 bytes of metadata per node without following links
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicVectorizedBestFitIndex : public GeneralBlockRules
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicVectorizedBestFitIndex<OtherSizeType, OtherNodeIDType>;
+
+			static_assert(std::is_same<SizeType, uint32>::value, "Best fit kernels scan 32-bit sizes");
+
+			inline void Reserve(uint32) {};
+			inline void Trim() {};
+			inline size_t GetMemorySize() const { return 0; };
+			template<typename NodeStorage>
+			inline void Insert(NodeStorage&, NodeIDType) {};
+			template<typename NodeStorage>
+			inline void Remove(NodeStorage&, NodeIDType) {};
+			inline void Clear() {};
+
+			template<typename NodeStorage>
+			inline NodeIDType First(const NodeStorage& Nodes, NodeIDType) const
+			{
+				return ToNodeID(FindBestFit(Nodes.GetSizes(), Nodes.GetFreeFlags(), (uint32)Nodes.size(), 1));
+			};
+
+			template<typename NodeStorage>
+			inline NodeIDType Find(const NodeStorage& Nodes, NodeIDType, SizeType size)
+			{
+				return ToNodeID(FindBestFit(Nodes.GetSizes(), Nodes.GetFreeFlags(), (uint32)Nodes.size(), size));
+			};
+
+		private:
+			// Kernels return 32 bit node index
+			static inline NodeIDType ToNodeID(uint32 NodeIndex)
+			{
+				return NodeIndex != DynamicAllocatorDetails::InvalidNodeID ? (NodeIDType)NodeIndex : InvalidNodeID;
+			};
+		};
+
+		using VectorizedBestFitIndex = BasicVectorizedBestFitIndex<>;
+
+		// Free block index with general block rules, which rounds sizes of blocks and regions up to multiple of BlockGranularity bytes.
+		// Allocator aligns regions, so every returned pointer is aligned to BlockGranularity and neighbor allocations never share
+		// a cache line(64 bytes by default), it removes false sharing between threads writing to their own allocations
+		template<typename FreeBlockIndex = ExplicitFreeListIndex<>, uint32 BlockGranularity = 64>
+		class GranularIndex : public FreeBlockIndex
+		{
+		public:
+			static_assert(std::is_base_of<GeneralBlockRules, FreeBlockIndex>::value, "Granularity needs free block index with general block rules");
+			static_assert(BlockGranularity != 0 && (BlockGranularity & (BlockGranularity - 1)) == 0 && BlockGranularity <= MaxAllocationAlignment,
+				"Granularity must be a power of two up to MaxAllocationAlignment");
+
+			using SizeType = typename FreeBlockIndex::SizeType;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = GranularIndex<typename FreeBlockIndex::template Rebind<OtherSizeType, OtherNodeIDType>, BlockGranularity>;
+
+			constexpr static uint32 Granularity = BlockGranularity;
+
+			static inline SizeType RoundRequest(SizeType size)
+			{
+				SizeType RoundedSize = (size + Granularity - 1) & ~(SizeType)(Granularity - 1);
+				return RoundedSize >= size ? RoundedSize : 0;
+			};
+
+			static inline SizeType RoundRegionSize(SizeType size)
+			{
+				SizeType RoundedSize = (size + Granularity - 1) & ~(SizeType)(Granularity - 1);
+				return RoundedSize >= size ? RoundedSize : size & ~(SizeType)(Granularity - 1);
+			};
+		};
+
+		// ==================== OCCUPIED BLOCK INDEXES
+		// Occupied block index finds the node of an allocation by the pointer returned to the user.
+		// Dynamic allocator notifies index with Insert when node is allocated and with Remove when it is freed,
+		// with Split when a new node is cut from the end of a node and with Merge when a free node is merged into its neighbor(before its ID is released).
+		// InsertRegion/RemoveRegion are called when primary allocated block of memory is added or released,
+		// InsertRegion returns false if the index can't cover memory of the region, then the region isn't added.
+		// GrowRegion is called with the old size when region grows in place, it returns false if the index can't cover the new memory.
+		// FindContaining finds the node which contains any(interior) address.
+		// Trim releases memory which is not used after Clear, GetMemorySize returns bytes of memory held by the index.
+		// Index of other widths of sizes and node IDs is Rebind<SizeType, NodeIDType>.
+		// Returned pointer is placed HeaderSize bytes after the start of the node's memory.
+
+		// Hash table from returned pointer to the node(default), buckets are intrusive lists of node IDs.
+		// Table grows by linear hashing: one bucket is split when the load factor is exceeded,
+		// so growing past reserved size never rehashes all nodes at once, bucket heads and links are kept in chunks
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicHashAddressIndex
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicHashAddressIndex<OtherSizeType, OtherNodeIDType>;
+
+			constexpr static uint32 HeaderSize = 0;
+			constexpr static uint32 MinBucketCount = 16;
+			// Max average count of nodes in a bucket
+			constexpr static uint32 MaxLoadFactor = 1;
+
+			BasicHashAddressIndex()
+			{
+				Clear();
+			};
+
+			// Buckets for MaxAllocations nodes are made up front when the index is empty
+			void Reserve(uint32 MaxAllocations)
+			{
+				NextNodeIndexes.reserve(MaxAllocations);
+				if (NodesCount != 0)
+					return;
+				while (ReservedBucketCount * MaxLoadFactor < MaxAllocations)
+					ReservedBucketCount *= 2;
+				ResetBuckets();
+			};
+
+			// Memory of buckets and links is released only when the index is empty(after Clear)
+			void Trim()
+			{
+				if (NodesCount != 0)
+					return;
+				ReservedBucketCount = MinBucketCount;
+				ResetBuckets();
+				Buckets.shrink_to_fit();
+				NextNodeIndexes.clear();
+				NextNodeIndexes.shrink_to_fit();
+			};
+
+			inline size_t GetMemorySize() const { return Buckets.GetMemorySize() + NextNodeIndexes.GetMemorySize(); };
+
+			template<typename NodeStorage>
+			void Insert(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				if (NodeIndex >= NextNodeIndexes.size())
+					NextNodeIndexes.resize(NodeIndex + 1, NodeIDType{ InvalidNodeID });
+
+				NodeIDType& BucketHead = Buckets[GetBucketIndex(Nodes.at(NodeIndex).NodeMemory)];
+				NextNodeIndexes[NodeIndex] = BucketHead;
+				BucketHead = NodeIndex;
+
+				NodesCount++;
+				if (NodesCount > Buckets.size() * MaxLoadFactor)
+					SplitBucket(Nodes);
+			};
+
+			template<typename NodeStorage>
+			void Remove(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				NodeIDType* Link = &Buckets[GetBucketIndex(Nodes.at(NodeIndex).NodeMemory)];
+				while (*Link != NodeIndex)
+				{
+					if (*Link == InvalidNodeID)
+						return;
+					Link = &NextNodeIndexes[*Link];
+				}
+				*Link = NextNodeIndexes[NodeIndex];
+				NextNodeIndexes[NodeIndex] = InvalidNodeID;
+				NodesCount--;
+			};
+
+			// Bucket count goes back to the reserved one, chunks of buckets and links stay allocated
+			void Clear()
+			{
+				NextNodeIndexes.clear();
+				NodesCount = 0;
+				ResetBuckets();
+			};
+
+			template<typename NodeStorage>
+			inline void Split(NodeStorage&, NodeIDType, NodeIDType) {};
+			template<typename NodeStorage>
+			inline void Merge(NodeStorage&, NodeIDType, NodeIDType) {};
+
+			inline bool InsertRegion(const RegionType&, uint16) { return true; };
+			inline bool GrowRegion(const RegionType&, uint16, SizeType) { return true; };
+			inline void RemoveRegion(const RegionType&, uint16) {};
+
+			template<typename NodeStorage>
+			inline NodeIDType Find(const NodeStorage& Nodes, void* address) const
+			{
+				for (NodeIDType nodeIndex = Buckets[GetBucketIndex(address)]; nodeIndex != InvalidNodeID; nodeIndex = NextNodeIndexes[nodeIndex])
+				{
+					if (Nodes[nodeIndex].NodeMemory == address)
+						return nodeIndex;
+				}
+				return InvalidNodeID;
+			};
+
+			template<typename NodeStorage>
+			inline NodeIDType FindContaining(const NodeStorage& Nodes, NodeIDType HeadNodeIndex, const void* address) const
+			{
+				return FindContainingNodeInList(Nodes, HeadNodeIndex, address);
+			};
+
+		private:
+			// Fibonacci hashing, high bits of the product are folded into low ones, which select the bucket
+			static inline size_t HashAddress(const void* address)
+			{
+				uint64 Hash = (uint64)(uintptr_t)address * 0x9E3779B97F4A7C15ull;
+				return (size_t)(Hash ^ (Hash >> 32));
+			};
+
+			// Buckets before the split index are already split, their nodes are spread by one more bit of the hash
+			inline size_t GetBucketIndex(const void* address) const
+			{
+				size_t Hash = HashAddress(address);
+				size_t BucketIndex = Hash & (BaseBucketCount - 1);
+				if (BucketIndex < SplitBucketIndex)
+					BucketIndex = Hash & (2 * BaseBucketCount - 1);
+				return BucketIndex;
+			};
+
+			// Move nodes of the next bucket to split between it and the new bucket at the end
+			template<typename NodeStorage>
+			void SplitBucket(const NodeStorage& Nodes)
+			{
+				Buckets.push_back(NodeIDType{ InvalidNodeID });
+				NodeIDType nodeIndex = Buckets[SplitBucketIndex];
+				Buckets[SplitBucketIndex] = InvalidNodeID;
+				while (nodeIndex != InvalidNodeID)
+				{
+					NodeIDType nextNodeIndex = NextNodeIndexes[nodeIndex];
+					NodeIDType& BucketHead = Buckets[HashAddress(Nodes[nodeIndex].NodeMemory) & (2 * BaseBucketCount - 1)];
+					NextNodeIndexes[nodeIndex] = BucketHead;
+					BucketHead = nodeIndex;
+					nodeIndex = nextNodeIndex;
+				}
+
+				SplitBucketIndex++;
+				if (SplitBucketIndex == BaseBucketCount)
+				{
+					BaseBucketCount *= 2;
+					SplitBucketIndex = 0;
+				}
+			};
+
+			void ResetBuckets()
+			{
+				Buckets.clear();
+				Buckets.resize(ReservedBucketCount, NodeIDType{ InvalidNodeID });
+				BaseBucketCount = ReservedBucketCount;
+				SplitBucketIndex = 0;
+			};
+
+			// Heads of the lists of nodes in the buckets
+			ChunkedArray<NodeIDType> Buckets{};
+			// Next node in the bucket, indexed by node ID
+			ChunkedArray<NodeIDType> NextNodeIndexes{};
+			size_t NodesCount = 0;
+			// Power of two count of buckets before the current round of splits, buckets count is BaseBucketCount + SplitBucketIndex
+			size_t BaseBucketCount = MinBucketCount;
+			size_t SplitBucketIndex = 0;
+			size_t ReservedBucketCount = MinBucketCount;
+		};
+
+		using HashAddressIndex = BasicHashAddressIndex<>;
+
+		// In-band boundary tag with node ID is written in front of every allocation,
+		// so node is found by pointer arithmetic without any lookup structure.
+		// Costs HeaderSize bytes per allocation, address passed to Free must be a pointer returned by the allocator
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicBoundaryTagIndex
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicBoundaryTagIndex<OtherSizeType, OtherNodeIDType>;
+
+			struct BoundaryTag
+			{
+				NodeIDType NodeIndex;
+				// Inverted node ID, to reject pointers which weren't returned by the allocator or were already freed
+				NodeIDType Check;
+			};
+
+			constexpr static uint32 HeaderSize = sizeof(BoundaryTag);
+
+			inline void Reserve(uint32) {};
+			inline void Trim() {};
+			inline size_t GetMemorySize() const { return 0; };
+			inline void Clear() {};
+			inline bool InsertRegion(const RegionType&, uint16) { return true; };
+			inline bool GrowRegion(const RegionType&, uint16, SizeType) { return true; };
+			inline void RemoveRegion(const RegionType&, uint16) {};
+			template<typename NodeStorage>
+			inline void Split(NodeStorage&, NodeIDType, NodeIDType) {};
+			template<typename NodeStorage>
+			inline void Merge(NodeStorage&, NodeIDType, NodeIDType) {};
+
+			template<typename NodeStorage>
+			inline void Insert(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				BoundaryTag Tag{ NodeIndex, (NodeIDType)~NodeIndex };
+				// Blocks aren't aligned, so the tag is copied byte-wise
+				std::memcpy(Nodes.at(NodeIndex).NodeMemory, &Tag, sizeof(BoundaryTag));
+			};
+
+			template<typename NodeStorage>
+			inline void Remove(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				BoundaryTag Tag{ NodeIndex, NodeIndex };
+				std::memcpy(Nodes.at(NodeIndex).NodeMemory, &Tag, sizeof(BoundaryTag));
+			};
+
+			template<typename NodeStorage>
+			inline NodeIDType Find(const NodeStorage& Nodes, void* address) const
+			{
+				void* TagAddress = (void*)((uint8*)address - HeaderSize);
+				BoundaryTag Tag{};
+				std::memcpy(&Tag, TagAddress, sizeof(BoundaryTag));
+				if (Tag.Check != (NodeIDType)~Tag.NodeIndex || Tag.NodeIndex >= Nodes.size())
+					return InvalidNodeID;
+
+				typename NodeStorage::ConstReference TaggedNode = Nodes[Tag.NodeIndex];
+				if (TaggedNode.NodeMemory != TagAddress || TaggedNode.IsBlockFree == 1)
+					return InvalidNodeID;
+				return Tag.NodeIndex;
+			};
+
+			template<typename NodeStorage>
+			inline NodeIDType FindContaining(const NodeStorage& Nodes, NodeIDType HeadNodeIndex, const void* address) const
+			{
+				return FindContainingNodeInList(Nodes, HeadNodeIndex, address);
+			};
+		};
+
+		using BoundaryTagIndex = BasicBoundaryTagIndex<>;
+
+		// Dense array of node addresses searched by the pointer match kernel, requires SoANodeStorage.
+		// Doesn't keep any state(no extra memory and no work on allocate/free), lookup is linear but compares 4-8 pointers per instruction
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicVectorizedAddressIndex
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicVectorizedAddressIndex<OtherSizeType, OtherNodeIDType>;
+
+			constexpr static uint32 HeaderSize = 0;
+
+			inline void Reserve(uint32) {};
+			inline void Trim() {};
+			inline size_t GetMemorySize() const { return 0; };
+			inline void Clear() {};
+			inline bool InsertRegion(const RegionType&, uint16) { return true; };
+			inline bool GrowRegion(const RegionType&, uint16, SizeType) { return true; };
+			inline void RemoveRegion(const RegionType&, uint16) {};
+			template<typename NodeStorage>
+			inline void Insert(NodeStorage&, NodeIDType) {};
+			template<typename NodeStorage>
+			inline void Remove(NodeStorage&, NodeIDType) {};
+			template<typename NodeStorage>
+			inline void Split(NodeStorage&, NodeIDType, NodeIDType) {};
+			template<typename NodeStorage>
+			inline void Merge(NodeStorage&, NodeIDType, NodeIDType) {};
+
+			template<typename NodeStorage>
+			inline NodeIDType Find(const NodeStorage& Nodes, void* address) const
+			{
+				// Only one live node starts at the address(invalidated nodes have no memory), it must be occupied
+				uint32 NodeIndex = FindPointer(Nodes.GetPointers(), (uint32)Nodes.size(), address);
+				if (NodeIndex == DynamicAllocatorDetails::InvalidNodeID || Nodes.GetFreeFlags()[NodeIndex] != 0)
+					return InvalidNodeID;
+				return (NodeIDType)NodeIndex;
+			};
+
+			template<typename NodeStorage>
+			inline NodeIDType FindContaining(const NodeStorage& Nodes, NodeIDType HeadNodeIndex, const void* address) const
+			{
+				return FindContainingNodeInList(Nodes, HeadNodeIndex, address);
+			};
+		};
+
+		using VectorizedAddressIndex = BasicVectorizedAddressIndex<>;
+
+		// Radix tree(tcmalloc-like page map) from page number to node ID, covers every region of the allocator.
+		// Page entry keeps the region of the page and a hint node from the same region,
+		// lookup walks through the list of nodes from the hint to the node which contains the address.
+		// Hint is written for every page covered by an allocation and moved to the remaining node on split and merge,
+		// so every page shared with an allocation has a hint which overlaps the page and lookup of an allocated address is O(1).
+		// Inner pages of free blocks may keep outdated hints, their lookup starts from the closest previous page with valid hint,
+		// so lookup of an address inside of a free block is not bounded, it costs O(pages in the block) on the first lookup of the page
+		// (found node is written back as the page's hint)
+		// Also answers which allocation contains an interior pointer
+		template<typename SizeT = uint32, typename NodeIDT = uint32>
+		class BasicPageMapIndex
+		{
+		public:
+			using SizeType = SizeT;
+			using NodeIDType = NodeIDT;
+			constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+			using RegionType = BasicMemoryRegion<SizeType, NodeIDType>;
+			template<typename OtherSizeType, typename OtherNodeIDType>
+			using Rebind = BasicPageMapIndex<OtherSizeType, OtherNodeIDType>;
+
+			constexpr static uint32 HeaderSize = 0;
+			constexpr static uint32 PageShift = 12;
+			constexpr static uint32 PageNumberBits = (sizeof(void*) == 8 ? 48 : 32) - PageShift;
+			constexpr static uint32 LeafBits = 12;
+			constexpr static uint32 MiddleBits = (PageNumberBits - LeafBits) / 2;
+			constexpr static uint32 RootBits = PageNumberBits - LeafBits - MiddleBits;
+
+			inline void Reserve(uint32) {};
+			inline void Trim() {};
+
+			size_t GetMemorySize() const
+			{
+				size_t MemorySize = Root.capacity() * sizeof(MiddleNode*) + Regions.capacity() * sizeof(RegionType);
+				for (const MiddleNode* Middle : Root)
+				{
+					if (Middle == nullptr)
+						continue;
+					MemorySize += sizeof(MiddleNode);
+					for (const LeafNode* Leaf : Middle->Leaves)
+						MemorySize += Leaf != nullptr ? sizeof(LeafNode) : 0;
+				}
+				return MemorySize;
+			};
+
+			void Clear()
+			{
+				for (MiddleNode* Middle : Root)
+				{
+					if (Middle == nullptr)
+						continue;
+					for (LeafNode* Leaf : Middle->Leaves)
+						delete Leaf;
+					delete Middle;
+				}
+				Root.clear();
+				Regions.clear();
+			};
+
+			~BasicPageMapIndex()
+			{
+				Clear();
+			};
+
+			bool InsertRegion(const RegionType& Region, uint16 RegionID)
+			{
+				// Pages are mapped in ascending order, so the last one is beyond the map if any of them is
+				uintptr_t LastPage = GetPageNumber((uint8*)Region.Memory + Region.Size - 1);
+				if (GetEntry(LastPage, true) == nullptr)
+					return false;
+
+				if (RegionID >= Regions.size())
+					Regions.resize(RegionID + 1);
+				Regions[RegionID] = Region;
+
+				for (uintptr_t Page = GetPageNumber(Region.Memory); Page <= LastPage; Page++)
+				{
+					PageEntry* Entry = GetEntry(Page, true);
+					Entry->NodeIndex = Region.PrimaryNodeIndex;
+					Entry->RegionID = RegionID;
+				}
+				return true;
+			};
+
+			// Only pages added to the end of the region are mapped
+			bool GrowRegion(const RegionType& Region, uint16 RegionID, SizeType OldSize)
+			{
+				uintptr_t LastPage = GetPageNumber((uint8*)Region.Memory + Region.Size - 1);
+				if (GetEntry(LastPage, true) == nullptr)
+					return false;
+
+				Regions.at(RegionID) = Region;
+				for (uintptr_t Page = GetPageNumber((uint8*)Region.Memory + OldSize - 1) + 1; Page <= LastPage; Page++)
+				{
+					PageEntry* Entry = GetEntry(Page, true);
+					Entry->NodeIndex = Region.PrimaryNodeIndex;
+					Entry->RegionID = RegionID;
+				}
+				return true;
+			};
+
+			void RemoveRegion(const RegionType& Region, uint16 RegionID)
+			{
+				// Region which wasn't inserted(see InsertRegion) has no pages
+				if (RegionID >= Regions.size() || Regions[RegionID].Memory != Region.Memory)
+					return;
+				Regions[RegionID] = RegionType{};
+
+				uintptr_t FirstPage = GetPageNumber(Region.Memory);
+				uintptr_t LastPage = GetPageNumber((uint8*)Region.Memory + Region.Size - 1);
+				for (uintptr_t Page = FirstPage; Page <= LastPage; Page++)
+				{
+					PageEntry* Entry = GetEntry(Page, false);
+					if (Entry == nullptr || Entry->RegionID != RegionID)
+						continue;
+					*Entry = PageEntry{};
+
+					// First or last page may be shared with another region, then page goes to it
+					if (Page != FirstPage && Page != LastPage)
+						continue;
+					for (uint32 regionIndex = 0; regionIndex < Regions.size(); regionIndex++)
+					{
+						const RegionType& OtherRegion = Regions[regionIndex];
+						if (OtherRegion.Memory != nullptr && GetPageNumber(OtherRegion.Memory) <= Page &&
+							GetPageNumber((uint8*)OtherRegion.Memory + OtherRegion.Size - 1) >= Page)
+						{
+							Entry->NodeIndex = OtherRegion.PrimaryNodeIndex;
+							Entry->RegionID = (uint16)regionIndex;
+							break;
+						}
+					}
+				}
+			};
+
+			template<typename NodeStorage>
+			void Insert(NodeStorage& Nodes, NodeIDType NodeIndex)
+			{
+				typename NodeStorage::ConstReference Node = Nodes.at(NodeIndex);
+				uintptr_t LastPage = GetPageNumber((uint8*)Node.NodeMemory + Node.Size - 1);
+				for (uintptr_t Page = GetPageNumber(Node.NodeMemory); Page <= LastPage; Page++)
+				{
+					PageEntry* Entry = GetEntry(Page, false);
+					if (Entry != nullptr && Entry->RegionID == Node.RegionID)
+						Entry->NodeIndex = NodeIndex;
+				}
+			};
+
+			// Freed node keeps its memory, so its hints stay valid
+			template<typename NodeStorage>
+			inline void Remove(NodeStorage&, NodeIDType) {};
+
+			// The kept node doesn't cover pages of the new node anymore, they may be shared with the next allocation
+			template<typename NodeStorage>
+			void Split(NodeStorage& Nodes, NodeIDType, NodeIDType NewNodeIndex)
+			{
+				typename NodeStorage::ConstReference NewNode = Nodes.at(NewNodeIndex);
+				SetHint(Nodes, NewNodeIndex, GetPageNumber(NewNode.NodeMemory));
+				SetHint(Nodes, NewNodeIndex, GetPageNumber((const uint8*)NewNode.NodeMemory + NewNode.Size - 1));
+			};
+
+			// The first and the last pages of merged node may be shared with allocations, their hints go to the node which took its memory
+			template<typename NodeStorage>
+			void Merge(NodeStorage& Nodes, NodeIDType NodeIndex, NodeIDType MergedNodeIndex)
+			{
+				typename NodeStorage::ConstReference MergedNode = Nodes.at(MergedNodeIndex);
+				SetHint(Nodes, NodeIndex, GetPageNumber(MergedNode.NodeMemory));
+				SetHint(Nodes, NodeIndex, GetPageNumber((const uint8*)MergedNode.NodeMemory + MergedNode.Size - 1));
+			};
+
+			template<typename NodeStorage>
+			inline NodeIDType Find(const NodeStorage& Nodes, void* address) const
+			{
+				NodeIDType NodeIndex = FindContaining(Nodes, InvalidNodeID, address);
+				if (NodeIndex == InvalidNodeID || Nodes[NodeIndex].NodeMemory != address || Nodes[NodeIndex].IsBlockFree == 1)
+					return InvalidNodeID;
+				return NodeIndex;
+			};
+
+			template<typename NodeStorage>
+			NodeIDType FindContaining(const NodeStorage& Nodes, NodeIDType, const void* address) const
+			{
+				const uintptr_t Page = GetPageNumber(address);
+				const PageEntry* Entry = GetEntry(Page, false);
+				if (Entry == nullptr || Entry->RegionID == InvalidRegionID)
+					return InvalidNodeID;
+
+				// Outdated hint is possible only inside of a free block, the closest previous page with valid hint is at most
+				// at the start of the block(or the walk starts from the start of the region)
+				const uint16 RegionID = Entry->RegionID;
+				NodeIDType NodeIndex = Entry->NodeIndex;
+				if (!IsHintValid(Nodes, NodeIndex, RegionID, Page))
+				{
+					NodeIndex = Regions[RegionID].PrimaryNodeIndex;
+					for (uintptr_t PrevPage = Page, FirstPage = GetPageNumber(Regions[RegionID].Memory); PrevPage > FirstPage;)
+					{
+						PrevPage--;
+						const PageEntry* PrevEntry = GetEntry(PrevPage, false);
+						if (PrevEntry != nullptr && PrevEntry->RegionID == RegionID && IsHintValid(Nodes, PrevEntry->NodeIndex, RegionID, PrevPage))
+						{
+							NodeIndex = PrevEntry->NodeIndex;
+							break;
+						}
+					}
+				}
+
+				NodeIndex = WalkToContainingNode(Nodes, NodeIndex, address);
+				if (NodeIndex != InvalidNodeID)
+				{
+					Entry->NodeIndex = NodeIndex;
+					return NodeIndex;
+				}
+
+				// Page is shared by two regions and the address belongs to the one which is not written in the entry
+				for (const RegionType& Region : Regions)
+				{
+					if (Region.Memory != nullptr && (const uint8*)address >= (const uint8*)Region.Memory && (const uint8*)address < (const uint8*)Region.Memory + Region.Size)
+						return WalkToContainingNode(Nodes, Region.PrimaryNodeIndex, address);
+				}
+				return InvalidNodeID;
+			};
+
+		private:
+			struct PageEntry
+			{
+				// Hint is only a cache of the lookup, so const FindContaining writes the found node back to it
+				mutable NodeIDType NodeIndex = InvalidNodeID;
+				uint16 RegionID = InvalidRegionID;
+			};
+
+			struct LeafNode
+			{
+				PageEntry Entries[1 << LeafBits];
+			};
+
+			struct MiddleNode
+			{
+				LeafNode* Leaves[1 << MiddleBits] = {};
+			};
+
+			static inline uintptr_t GetPageNumber(const void* address)
+			{
+				return (uintptr_t)address >> PageShift;
+			};
+
+			// Hint is valid if it's a live node of the region which overlaps the page(invalidated nodes have no size)
+			template<typename NodeStorage>
+			static inline bool IsHintValid(const NodeStorage& Nodes, NodeIDType NodeIndex, uint16 RegionID, uintptr_t Page)
+			{
+				if (NodeIndex >= Nodes.size())
+					return false;
+				typename NodeStorage::ConstReference Node = Nodes[NodeIndex];
+				return Node.Size != 0 && Node.RegionID == RegionID && GetPageNumber(Node.NodeMemory) <= Page &&
+					GetPageNumber((const uint8*)Node.NodeMemory + Node.Size - 1) >= Page;
+			};
+
+			// Point hint of the page to the node, if the page belongs to the node's region
+			template<typename NodeStorage>
+			inline void SetHint(const NodeStorage& Nodes, NodeIDType NodeIndex, uintptr_t Page)
+			{
+				PageEntry* Entry = GetEntry(Page, false);
+				if (Entry != nullptr && Entry->RegionID == Nodes[NodeIndex].RegionID)
+					Entry->NodeIndex = NodeIndex;
+			};
+
+			PageEntry* GetEntry(uintptr_t Page, bool Create) const
+			{
+				uintptr_t RootIndex = Page >> (LeafBits + MiddleBits);
+				uintptr_t MiddleIndex = (Page >> LeafBits) & ((1 << MiddleBits) - 1);
+				uintptr_t LeafIndex = Page & ((1 << LeafBits) - 1);
+				if (RootIndex >= ((uintptr_t)1 << RootBits))
+					return nullptr;
+
+				if (Root.empty())
+				{
+					if (!Create)
+						return nullptr;
+					Root.resize((size_t)1 << RootBits, nullptr);
+				}
+
+				MiddleNode*& Middle = Root[RootIndex];
+				if (Middle == nullptr)
+				{
+					if (!Create)
+						return nullptr;
+					Middle = new MiddleNode{};
+				}
+
+				LeafNode*& Leaf = Middle->Leaves[MiddleIndex];
+				if (Leaf == nullptr)
+				{
+					if (!Create)
+						return nullptr;
+					Leaf = new LeafNode{};
+				}
+				return &Leaf->Entries[LeafIndex];
+			};
+
+			// Walk through adjacent nodes of the region from the node to the one which contains the address
+			template<typename NodeStorage>
+			static NodeIDType WalkToContainingNode(const NodeStorage& Nodes, NodeIDType NodeIndex, const void* address)
+			{
+				while ((const uint8*)address < (const uint8*)Nodes[NodeIndex].NodeMemory)
+				{
+					if (Nodes[NodeIndex].IsPrevNodeAdjacent == 0)
+						return InvalidNodeID;
+					NodeIndex = Nodes[NodeIndex].PrevNodeIndex;
+				}
+				while ((const uint8*)address >= (const uint8*)Nodes[NodeIndex].NodeMemory + Nodes[NodeIndex].Size)
+				{
+					if (Nodes[NodeIndex].IsNextNodeAdjacent == 0)
+						return InvalidNodeID;
+					NodeIndex = Nodes[NodeIndex].NextNodeIndex;
+				}
+				return NodeIndex;
+			};
+
+			// Mutable for GetEntry, which is shared by const lookups(they never create entries)
+			mutable std::vector<MiddleNode*> Root{};
+			// Copy of the regions of the allocator, indexed by region ID
+			std::vector<RegionType> Regions{};
+		};
+
+		using PageMapIndex = BasicPageMapIndex<>;
+
+#if DYNAMIC_ALLOCATOR_USE_MALLOC == 1
+#include <malloc.h>
+
+		class DYNAMIC_ALLOCATOR_MALLOC
+		{
+		public:
+			using pointer = void*;
+			static inline pointer Allocate(size_t allocationsize)
+			{
+				pointer allocation = malloc(allocationsize);
+				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: MALLOC: ALLOCATED AT ADDRESS: " << allocation);
+				return allocation;
+			};
+
+			static inline bool Deallocate(pointer allocation)
+			{
+				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: MALLOC: CALL TO DEALLOCATE AT ADDRESS: " << allocation);
+
+				free(allocation);
+				return true;
+			};
+		};
+#endif
+
+#if defined(__linux__)
+		// Maps every allocation with mmap, allocation starts at the second page of the mapping,
+		// the first page keeps size of the mapping for munmap.
+		// Release gives pages of free blocks back to the kernel, their addresses stay mapped and read zeros when touched again
+		class DYNAMIC_ALLOCATOR_MMAP
+		{
+		public:
+			using pointer = void*;
+			static inline pointer Allocate(size_t allocationsize)
+			{
+				const size_t PageSize = GetPageSize();
+				if (allocationsize > std::numeric_limits<size_t>::max() - 2 * PageSize)
+					return nullptr;
+				size_t MappingSize = (allocationsize + 2 * PageSize - 1) & ~(PageSize - 1);
+				void* Mapping = mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (Mapping == MAP_FAILED)
+					return nullptr;
+				*(size_t*)Mapping = MappingSize;
+				pointer allocation = (uint8*)Mapping + PageSize;
+				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: MMAP: MAPPED AT ADDRESS: " << allocation);
+				return allocation;
+			};
+
+			static inline bool Deallocate(pointer allocation)
+			{
+				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: MMAP: CALL TO UNMAP AT ADDRESS: " << allocation);
+				void* Mapping = (uint8*)allocation - GetPageSize();
+				return munmap(Mapping, *(size_t*)Mapping) == 0;
+			};
+
+			// Give whole pages inside of the memory back to the kernel
+			static inline void Release(void* memory, size_t size)
+			{
+				const size_t PageSize = GetPageSize();
+				uintptr_t FirstPage = ((uintptr_t)memory + PageSize - 1) & ~(uintptr_t)(PageSize - 1);
+				uintptr_t EndPage = ((uintptr_t)memory + size) & ~(uintptr_t)(PageSize - 1);
+				if (FirstPage < EndPage)
+					madvise((void*)FirstPage, EndPage - FirstPage, MADV_DONTNEED);
+			};
+
+			static inline size_t GetPageSize()
+			{
+				static const size_t PageSize = (size_t)sysconf(_SC_PAGESIZE);
+				return PageSize;
+			};
+
+			// Release gives back only whole units of this size
+			static inline size_t GetReleaseGranularity() { return GetPageSize(); };
+		};
+
+		// Reserves ReservationSize bytes of address space for every allocation and commits only the allocated memory.
+		// Grow commits more of the reservation right after the allocation, so allocator extends its last region in place
+		// and free memory of the region stays coalescible. The first page keeps sizes of the reservation and of the allocation.
+		// Release is the same as in DYNAMIC_ALLOCATOR_MMAP.
+		// Default reservation is 64GB on 64 bit systems(256MB on 32 bit). It's only address space(PROT_NONE, MAP_NORESERVE),
+		// so it costs neither memory nor commit charge, 128TB of user address space fits 2048 of such regions,
+		// and allocator with uint32 sizes never outgrows it, so its Resize never falls back to adding a region
+		template<size_t ReservationSize = (sizeof(void*) == 8 ? (size_t)64 << 30 : (size_t)256 << 20)>
+		class DYNAMIC_ALLOCATOR_VIRTUAL_ARENA : public DYNAMIC_ALLOCATOR_MMAP
+		{
+		public:
+			using pointer = void*;
+			static inline pointer Allocate(size_t allocationsize)
+			{
+				const size_t PageSize = GetPageSize();
+				if (allocationsize > std::numeric_limits<size_t>::max() - 2 * PageSize)
+					return nullptr;
+				size_t CommittedSize = (allocationsize + 2 * PageSize - 1) & ~(PageSize - 1);
+				size_t ReservedSize = std::max(CommittedSize, ReservationSize & ~(PageSize - 1));
+				void* Mapping = mmap(nullptr, ReservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+				if (Mapping == MAP_FAILED)
+					return nullptr;
+				if (mprotect(Mapping, CommittedSize, PROT_READ | PROT_WRITE) != 0)
+				{
+					munmap(Mapping, ReservedSize);
+					return nullptr;
+				}
+				*(ArenaHeader*)Mapping = ArenaHeader{ ReservedSize, allocationsize };
+				pointer allocation = (uint8*)Mapping + PageSize;
+				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: VIRTUAL ARENA: RESERVED AT ADDRESS: " << allocation);
+				return allocation;
+			};
+
+			static inline bool Deallocate(pointer allocation)
+			{
+				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: VIRTUAL ARENA: CALL TO UNMAP AT ADDRESS: " << allocation);
+				void* Mapping = (uint8*)allocation - GetPageSize();
+				return munmap(Mapping, ((ArenaHeader*)Mapping)->ReservedSize) == 0;
+			};
+
+			// Extend the allocation by size bytes in place, false if the reservation is too small
+			static inline bool Grow(pointer allocation, size_t size)
+			{
+				const size_t PageSize = GetPageSize();
+				uint8* Mapping = (uint8*)allocation - PageSize;
+				ArenaHeader& Header = *(ArenaHeader*)Mapping;
+				if (size > Header.ReservedSize - PageSize - Header.AllocatedSize)
+					return false;
+				size_t CommittedSize = (Header.AllocatedSize + 2 * PageSize - 1) & ~(PageSize - 1);
+				size_t NewCommittedSize = (Header.AllocatedSize + size + 2 * PageSize - 1) & ~(PageSize - 1);
+				if (NewCommittedSize > CommittedSize && mprotect(Mapping + CommittedSize, NewCommittedSize - CommittedSize, PROT_READ | PROT_WRITE) != 0)
+					return false;
+				Header.AllocatedSize += size;
+				return true;
+			};
+
+		private:
+			struct ArenaHeader
+			{
+				size_t ReservedSize;
+				size_t AllocatedSize;
+			};
+		};
+
+		// Regions are backed by 2MB pages, explicit huge pages(MAP_HUGETLB) are taken when the system has them reserved,
+		// otherwise the mapping is aligned to 2MB and marked for transparent huge pages(MADV_HUGEPAGE).
+		// Sizes of allocations are rounded to whole huge pages, the first HeaderSize bytes keep size of the mapping for munmap.
+		// Release gives back only whole huge pages, so they are never split
+		class DYNAMIC_ALLOCATOR_HUGE_PAGES
+		{
+		public:
+			using pointer = void*;
+			constexpr static size_t HugePageSize = 2 * 1024 * 1024;
+			constexpr static size_t HeaderSize = 64;
+
+			// Allocation of the rounded size takes the same huge pages
+			static inline size_t RoundAllocationSize(size_t allocationsize)
+			{
+				if (allocationsize > std::numeric_limits<size_t>::max() - HeaderSize - HugePageSize)
+					return allocationsize;
+				return ((allocationsize + HeaderSize + HugePageSize - 1) & ~(HugePageSize - 1)) - HeaderSize;
+			};
+
 			static inline pointer Allocate(size_t allocationsize)
 			{
-				pointer allocation = malloc(allocationsize);
-				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: MALLOC: ALLOCATED AT ADDRESS: " << allocation);
+				if (allocationsize > std::numeric_limits<size_t>::max() - HeaderSize - 2 * HugePageSize)
+					return nullptr;
+				size_t MappingSize = RoundAllocationSize(allocationsize) + HeaderSize;
+				void* Mapping = mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+				if (Mapping == MAP_FAILED)
+				{
+					// Map one huge page more and unmap the ends, so the mapping starts at huge page boundary
+					uint8* ExtendedMapping = (uint8*)mmap(nullptr, MappingSize + HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+					if (ExtendedMapping == MAP_FAILED)
+						return nullptr;
+					uint8* AlignedMapping = (uint8*)(((uintptr_t)ExtendedMapping + HugePageSize - 1) & ~(uintptr_t)(HugePageSize - 1));
+					size_t HeadSize = AlignedMapping - ExtendedMapping;
+					if (HeadSize > 0)
+						munmap(ExtendedMapping, HeadSize);
+					munmap(AlignedMapping + MappingSize, HugePageSize - HeadSize);
+					madvise(AlignedMapping, MappingSize, MADV_HUGEPAGE);
+					Mapping = AlignedMapping;
+				}
+				*(size_t*)Mapping = MappingSize;
+				pointer allocation = (uint8*)Mapping + HeaderSize;
+				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: HUGE PAGES: MAPPED AT ADDRESS: " << allocation);
 				return allocation;
 			};
 
 			static inline bool Deallocate(pointer allocation)
 			{
-				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: MALLOC: CALL TO DEALLOCATE AT ADDRESS: " << allocation);
+				DYNAMIC_ALLOCATOR_REPORT(" DYNAMIC ALLOCATOR: HUGE PAGES: CALL TO UNMAP AT ADDRESS: " << allocation);
+				void* Mapping = (uint8*)allocation - HeaderSize;
+				return munmap(Mapping, *(size_t*)Mapping) == 0;
+			};
 
-				free(allocation);
-				return true;
+			static inline size_t GetReleaseGranularity() { return HugePageSize; };
+
+			// Give whole huge pages inside of the memory back to the kernel
+			static inline void Release(void* memory, size_t size)
+			{
+				uintptr_t FirstPage = ((uintptr_t)memory + HugePageSize - 1) & ~(uintptr_t)(HugePageSize - 1);
+				uintptr_t EndPage = ((uintptr_t)memory + size) & ~(uintptr_t)(HugePageSize - 1);
+				if (FirstPage < EndPage)
+					madvise((void*)FirstPage, EndPage - FirstPage, MADV_DONTNEED);
 			};
 		};
 #endif
+
+		// Internal allocator may have static Release(memory, size), allocator calls it for big free blocks(see ReleaseMinBlockSize),
+		// such allocator also has GetReleaseGranularity(), pages of this size are released only as a whole
+		template<typename Allocator, typename = void>
+		struct HasRelease : std::false_type {};
+		template<typename Allocator>
+		struct HasRelease<Allocator, decltype(Allocator::Release(nullptr, 0))> : std::true_type {};
+
+		// Internal allocator may have static RoundAllocationSize(size), which returns size of memory it really gives for the size,
+		// regions take all of it
+		template<typename Allocator, typename = void>
+		struct HasRoundAllocationSize : std::false_type {};
+		template<typename Allocator>
+		struct HasRoundAllocationSize<Allocator, decltype(Allocator::RoundAllocationSize(0), void())> : std::true_type {};
+
+		template<typename Allocator>
+		inline size_t RoundAllocationSize(size_t size, std::true_type) { return Allocator::RoundAllocationSize(size); };
+		template<typename Allocator>
+		inline size_t RoundAllocationSize(size_t size, std::false_type) { return size; };
+
+		// Internal allocator may have static Grow(allocation, size), which extends the allocation in place,
+		// then allocator grows its last region instead of adding a new one
+		template<typename Allocator, typename = void>
+		struct HasGrow : std::false_type {};
+		template<typename Allocator>
+		struct HasGrow<Allocator, decltype(Allocator::Grow(nullptr, 0), void())> : std::true_type {};
 	}
 
 	using namespace harz::DynamicAllocatorDetails;
 
 	// Dynamic allocator
 	// General allocator for medium/big size allocations
-	// NOTE: Returned pointer is not aligned by the allocator itself. (TODO: Alignment of allocation)
-	// Template allocator type should have static member functions Allocate/Deallocate with arguments as in DYNAMIC_ALLOCATOR_MALLOC
+	// NOTE: Pointer returned by Allocate is not aligned by the allocator itself, AllocateAligned aligns it(not with BuddyIndex)
+	// Template allocator type should have static member functions Allocate/Deallocate with arguments as in DYNAMIC_ALLOCATOR_MALLOC,
+	// optional Release(memory, size) with GetReleaseGranularity() gives pages of big free blocks back to the system(DYNAMIC_ALLOCATOR_MMAP on Linux),
+	// optional RoundAllocationSize(size) lets regions take whole pages of the allocation(DYNAMIC_ALLOCATOR_HUGE_PAGES on Linux),
+	// optional Grow(allocation, size) lets the last region grow in place(DYNAMIC_ALLOCATOR_VIRTUAL_ARENA on Linux)
+	// Template free block index type selects how free nodes are searched:
+	// ExplicitFreeListIndex<FitPolicy>(default), LinearScanIndex<FitPolicy>, SegregatedFitIndex or SizeOrderedTreeIndex,
+	// FitPolicy of scanning indexes is one of BestFit(default), FirstFit, NextFit or GoodFit<MaxWaste>,
+	// BuddyIndex<MinBlockLog2> switches allocator to the buddy system(power of two blocks),
+	// VectorizedBestFitIndex(SoANodeStorage only) searches with SIMD kernel,
+	// GranularIndex<FreeBlockIndex, Granularity> aligns all blocks to cache lines(or other granularity)
+	// Template occupied block index type selects how Free finds the node of an allocation:
+	// HashAddressIndex(default), BoundaryTagIndex, PageMapIndex or VectorizedAddressIndex(SoANodeStorage only)
+	// Template node storage type selects layout of nodes metadata: AoSNodeStorage(default), SoANodeStorage
+	// or PackedNodeStorage(region-relative offsets instead of pointers),
+	// AoS and packed nodes are kept in chunks, so growing past MaxAllocations never copies metadata,
+	// HashAddressIndex grows by one bucket at a time, so it never rehashes all nodes at once either
+	// Template SizeT selects width of sizes(uint32 by default, uint64 for arenas larger than 4 GiB),
+	// NodeIDT selects width of node IDs(uint16 for small heaps of less than 65535 nodes, uint32 by default or uint64),
+	// storage and indexes are rebound to both of them. Allocation fails when all node IDs are taken
 
 #if DYNAMIC_ALLOCATOR_USE_MALLOC == 1
-	template<typename Allocator = DYNAMIC_ALLOCATOR_MALLOC>
+	template<typename Allocator = DYNAMIC_ALLOCATOR_MALLOC, typename FreeBlockIndex = ExplicitFreeListIndex<>, typename OccupiedBlockIndex = HashAddressIndex, typename NodeStorage = AoSNodeStorage,
+		typename SizeT = uint32, typename NodeIDT = uint32>
 #else
-	template<typename Allocator>
+	template<typename Allocator, typename FreeBlockIndex = ExplicitFreeListIndex<>, typename OccupiedBlockIndex = HashAddressIndex, typename NodeStorage = AoSNodeStorage,
+		typename SizeT = uint32, typename NodeIDT = uint32>
 #endif
 	class DynamicAllocator
 	{
 	public:
 		using MemPtr = void*;
-		using NodeIDType = uint32;
-		using SizeType = uint32;
+		using NodeIDType = NodeIDT;
+		constexpr static NodeIDType InvalidNodeID = std::numeric_limits<NodeIDType>::max();
+		using SizeType = SizeT;
 		using InternalAllocator = Allocator;
-
-		DynamicAllocator(SizeType BaseAllocationSize, uint32 MaxAllocations = MaxAllocationsDefault);
+		// Storage and indexes with the sizes and node IDs of the allocator
+		using NodeStorageType = typename NodeStorage::template Rebind<SizeType, NodeIDType>;
+		using FreeIndexType = typename FreeBlockIndex::template Rebind<SizeType, NodeIDType>;
+		using OccupiedIndexType = typename OccupiedBlockIndex::template Rebind<SizeType, NodeIDType>;
+		using MemoryHeaderBlockNode = BasicMemoryHeaderBlockNode<SizeType, NodeIDType>;
+		using MemoryRegion = BasicMemoryRegion<SizeType, NodeIDType>;
+		using NodeReference = typename NodeStorageType::Reference;
+		using ConstNodeReference = typename NodeStorageType::ConstReference;
+
+		static_assert(std::is_unsigned<SizeType>::value && std::is_unsigned<NodeIDType>::value, "Sizes and node IDs must be unsigned");
+		static_assert(sizeof(SizeType) >= sizeof(uint32), "Size type must be at least 32 bits");
+		static_assert(sizeof(NodeIDType) >= sizeof(uint16), "Node IDs must be at least 16 bits");
+
+		// MaxAllocations is only a hint, metadata for that many nodes is reserved up front in Eager reservation mode
+		DynamicAllocator(SizeType BaseAllocationSize, uint32 MaxAllocations = MaxAllocationsDefault,
+			MetadataReservation Reservation = MetadataReservation::Eager);
 		~DynamicAllocator();
 		DynamicAllocator(DynamicAllocator&) = delete;
 		DynamicAllocator(DynamicAllocator&&) = delete;
@@ -137,12 +2796,32 @@ namespace harz
 		// Allocate block of memory from FreeList free space
 		void* Allocate(SizeType size);
 
+		// Allocate block of memory with returned pointer aligned to power of two alignment up to MaxAllocationAlignment,
+		// leading padding goes back to free space as a separate block. Pointer is freed by Free as usual
+		void* AllocateAligned(SizeType size, SizeType alignment);
+
 		// Deallocate block of memory from FreeList free space
 		bool Free(void* address);
 
+		// Find allocation which contains the address(interior pointer)
+		// With PageMapIndex an address inside of a free block costs O(pages in the block), other indexes walk the list of nodes
+		// Return pointer returned by Allocate for this allocation or nullptr if the address is not inside of any allocation
+		void* FindAllocation(const void* address) const;
+
+		// Renumber nodes in the order of the list and drop invalid nodes,
+		// so traversal of the list goes sequentially through metadata. Indexes are rebuilt with new node IDs
+		inline void CompactMetadata() { RebuildMetadata(false); };
+		// Compact metadata and release its memory which is not used by current nodes(e.g. after a burst of allocations)
+		inline void TrimMetadata() { RebuildMetadata(true); };
+
 		inline SizeType GetTotalSize() const { return TotalSize; };
 		inline SizeType GetFreeSpaceSize() const { return FreeSpaceSize; };
 		inline SizeType GetOccupiedSpace() const { DYNAMIC_ALLOCATOR_ASSERT(FreeSpaceSize <= TotalSize); return TotalSize - FreeSpaceSize; };
+		// Bytes of memory held by nodes, regions and indexes, it isn't counted in total size
+		inline size_t GetMetadataSize() const
+		{
+			return Nodes.GetMemorySize() + Regions.capacity() * sizeof(MemoryRegion) + FreeIndex.GetMemorySize() + OccupiedIndex.GetMemorySize();
+		};
 #if DYNAMIC_ALLOCATOR_STATS == 1
 		std::string GetAllocatorStats() const;
 #endif
@@ -151,18 +2830,54 @@ namespace harz
 
 	private:
 		MemoryHeaderBlockNode GetNodeMetadata(MemPtr nodeMemory);
-		SizeType GetFreeNodeIndex();
+		NodeIDType GetFreeNodeIndex();
 		SizeType GetNodeSize(MemPtr nodeMemory);
 
-		inline bool CheckAndSetFreeIdsUse()
+		// Remove node from the list of nodes, its neighbors are linked to each other
+		void UnlinkNode(NodeIDType NodeIndex);
+
+		// Find free node of at least size bytes, allocator is resized if there is no such node
+		NodeIDType FindFreeNode(SizeType size);
+		// Cut memory after KeptSize bytes of the node into a new free node next to it in the list(not inserted into free index)
+		// Return ID of the new node or InvalidNodeID if all node IDs are taken
+		NodeIDType SplitNode(NodeIDType NodeIndex, SizeType KeptSize);
+		// Allocate node removed from free index, remained memory is split into free nodes while index allows it
+		// Return pointer to the allocation
+		void* OccupyNode(NodeIDType NodeIndex, SizeType size);
+
+		// Put node into the free slot of nodes array(or at the end of it), return its ID
+		// Return InvalidNodeID if all node IDs are taken
+		NodeIDType AddNode(MemoryHeaderBlockNode& NewNode);
+		// Count of nodes which can still be added
+		inline size_t GetAvailableNodeIDsCount() const { return (size_t)FreeNodeIDsCount + ((size_t)InvalidNodeID - Nodes.size()); };
+
+		// Add primary allocated block of memory as new free nodes at the end of the list
+		bool AddRegion(SizeType size);
+		// Extend the region of the last node in place if internal allocator can grow it(see HasGrow),
+		// the last node takes the memory if it's free, otherwise the memory becomes a new free node.
+		// Buddy blocks can't be carved from the end of region, so only general block rules grow
+		inline bool GrowLastRegion(SizeType size)
 		{
-			if (NodesFreeIdsBin.size() > FreeIdsUseThreshold)
-			{
-				UseFreeBinNodesID = 1;
-				return true;
-			}
-			return false;
+			return GrowLastRegion(size, std::integral_constant<bool, HasGrow<InternalAllocator>::value && std::is_base_of<GeneralBlockRules, FreeIndexType>::value>{});
 		};
+		bool GrowLastRegion(SizeType size, std::true_type);
+		inline bool GrowLastRegion(SizeType, std::false_type) { return false; };
+		// Are all nodes of the region free
+		bool IsRegionFree(NodeIDType PrimaryNodeIndex) const;
+		// Release primary allocated block of memory, all nodes of the region must be free
+		// Return the node next to the region in the list
+		NodeIDType RemoveRegion(NodeIDType PrimaryNodeIndex);
+
+		// Invalidate node and push its ID to the list of free IDs
+		void ReleaseNode(NodeIDType NodeIndex);
+
+		// Renumber nodes in the order of the list and rebuild indexes, optionally releasing unused memory of metadata
+		void RebuildMetadata(bool ReleaseMemory);
+
+		// Give pages of big free node back to the system if internal allocator can release them(see HasRelease),
+		// the unreleased range is memory of the node which wasn't released before
+		void ReleaseFreeNode(NodeIDType NodeIndex, uintptr_t UnreleasedBegin, uintptr_t UnreleasedEnd, std::true_type);
+		inline void ReleaseFreeNode(NodeIDType, uintptr_t, uintptr_t, std::false_type) {};
 
 		SizeType TotalSize = 0;
 		SizeType FreeSpaceSize = 0;
@@ -170,29 +2885,45 @@ namespace harz
 		NodeIDType HeadNodeIndex = InvalidNodeID;
 		NodeIDType LastNodeIndex = InvalidNodeID;
 
-		uint8 UseFreeBinNodesID : 1;
+		NodeStorageType Nodes{};
+		// Free IDs of invalid nodes are linked through NextNodeIndex of these nodes, last released ID is reused first
+		NodeIDType FreeNodeIDsHead = InvalidNodeID;
+		NodeIDType FreeNodeIDsCount = 0;
+
+		// Primary allocated blocks of memory, slot of released region is reused by the next one
+		std::vector<MemoryRegion> Regions{};
 
-		std::vector<MemoryHeaderBlockNode> Nodes{};
-		std::vector<NodeIDType> NodesFreeIdsBin{};
+		FreeIndexType FreeIndex{};
+
+		// Gives constant time lookup of allocations for Free/GetNodeSize/GetNodeMetadata
+		OccupiedIndexType OccupiedIndex{};
 	};
 
-	template<typename Allocator>
-	DynamicAllocator<Allocator>::DynamicAllocator(SizeType BaseAllocationSize, uint32 MaxAllocations)
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::DynamicAllocator(SizeType BaseAllocationSize, uint32 MaxAllocations, MetadataReservation Reservation)
 	{
-		Nodes.reserve(MaxAllocations);
-		NodesFreeIdsBin.reserve(MaxAllocations);
+		// There is no more nodes than node IDs
+		if (MaxAllocations > InvalidNodeID)
+			MaxAllocations = (uint32)InvalidNodeID;
+
+		if (Reservation == MetadataReservation::Eager)
+		{
+			Nodes.reserve(MaxAllocations);
+			OccupiedIndex.Reserve(MaxAllocations);
+			FreeIndex.Reserve(MaxAllocations);
+		}
 
 		Resize(BaseAllocationSize);
 	}
 
-	template<typename Allocator>
-	inline DynamicAllocator<Allocator>::~DynamicAllocator()
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	inline DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::~DynamicAllocator()
 	{
 		Clear();
 	};
 
-	template<typename Allocator>
-	bool DynamicAllocator<Allocator>::Resize(SizeType SizeToChange)
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	bool DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::Resize(SizeType SizeToChange)
 	{
 		bool result = true;
 
@@ -207,22 +2938,7 @@ namespace harz
 			// Head node must be invalid
 			DYNAMIC_ALLOCATOR_ASSERT(HeadNodeIndex == InvalidNodeID);
 
-			void* allocatedMemoryBlockForResize = InternalAllocator::Allocate(SizeToChange);
-			DYNAMIC_ALLOCATOR_ASSERT(allocatedMemoryBlockForResize && "Failed to allocated memory for Dynamic Allocator resize");
-
-			TotalSize = SizeToChange;
-			FreeSpaceSize = SizeToChange;
-			HeadNodeIndex = 0;
-			LastNodeIndex = 0;
-			MemoryHeaderBlockNode NewReservedNode{};
-			NewReservedNode.IsNextNodeAdjacent = 0;
-			NewReservedNode.IsPrimaryAllocated = 1;
-			NewReservedNode.IsBlockFree = 1;
-			NewReservedNode.NodeMemory = allocatedMemoryBlockForResize;
-			NewReservedNode.Size = SizeToChange;
-			NewReservedNode.NextNodeIndex = InvalidNodeID;
-			Nodes.push_back(std::move(NewReservedNode));
-
+			result = AddRegion(SizeToChange);
 		}
 		else
 		{
@@ -230,50 +2946,27 @@ namespace harz
 
 			// If the Size is less than the current size then this call SHOULD decrease the size of the allocator
 			// Try to fully deallocate memory from Allocator preallocated space
-			if (SizeToChange < TotalSize && FreeSpaceSize >= SizeToChange)
+			if (SizeToChange < TotalSize)
 			{
-				NodeIDType previousNodeID = InvalidNodeID;
-				for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
+				if (FreeSpaceSize >= SizeToChange)
 				{
-					auto& FreedNode = Nodes.at(nodeIndex);
-					if (FreedNode.IsPrimaryAllocated == 1 &&
-						FreedNode.IsBlockFree == 1 &&
-						FreedNode.IsNextNodeAdjacent == 0)
+					for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID;)
 					{
-						InternalAllocator::Deallocate(FreedNode.NodeMemory);
-						NodesFreeIdsBin.push_back(nodeIndex);
-						FreeSpaceSize -= FreedNode.Size;
-						TotalSize -= FreedNode.Size;
-
-						if (nodeIndex == HeadNodeIndex)
+						if (Nodes.at(nodeIndex).IsPrimaryAllocated == 1 && IsRegionFree(nodeIndex))
 						{
-							HeadNodeIndex = FreedNode.NextNodeIndex;
-						}
+							nodeIndex = RemoveRegion(nodeIndex);
 
-						if (previousNodeID != InvalidNodeID)
-						{
-							if (nodeIndex == LastNodeIndex)
-							{
-								LastNodeIndex = previousNodeID;
-							}
-							else
+							if (FreeSpaceSize <= SizeToChange || TotalSize <= SizeToChange)
 							{
-								Nodes.at(previousNodeID).NextNodeIndex = FreedNode.NextNodeIndex;
+								break;
 							}
-						};
-
-						// Invalidate node
-						FreedNode = MemoryHeaderBlockNode{};
-
-						if (FreeSpaceSize <= SizeToChange || TotalSize <= SizeToChange)
+						}
+						else
 						{
-							break;
+							nodeIndex = Nodes.at(nodeIndex).NextNodeIndex;
 						}
-					}
-					previousNodeID = nodeIndex;
-				};
-
-				CheckAndSetFreeIdsUse();
+					};
+				}
 
 				if (TotalSize >= SizeToChange || FreeSpaceSize >= SizeToChange)
 				{
@@ -281,222 +2974,507 @@ namespace harz
 				}
 			}
 			// If the size is more than the current size of allocated memory, allocate a new block and add it to the total space
-			else
+			else if (SizeToChange > TotalSize)
 			{
-				uint32 SizeToAllocate = SizeToChange - TotalSize;
-				void* allocatedMemoryBlockForResize = InternalAllocator::Allocate(SizeToAllocate);
-
-				DYNAMIC_ALLOCATOR_ASSERT(allocatedMemoryBlockForResize && "Failed to allocated memory for Dynamic Allocator resize");
-
-				MemoryHeaderBlockNode NewReservedNode{};
-				NewReservedNode.IsNextNodeAdjacent = 0;
-				NewReservedNode.IsPrimaryAllocated = 1;
-				NewReservedNode.IsBlockFree = 1;
-				NewReservedNode.NodeMemory = allocatedMemoryBlockForResize;
-				NewReservedNode.Size = SizeToAllocate;
-				NewReservedNode.NextNodeIndex = InvalidNodeID;
-				Nodes.push_back(std::move(NewReservedNode));
-
-				FreeSpaceSize += SizeToAllocate;
-				TotalSize = SizeToChange;
-
-				// Update data about the last node
-				if (LastNodeIndex == InvalidNodeID)
-				{
-					DYNAMIC_ALLOCATOR_ASSERT("LastNodeIndex should be valid at this point (bug?)");
-					LastNodeIndex = Nodes.size() - 1;
-				}
-				else
-				{
-					Nodes.at(LastNodeIndex).NextNodeIndex = Nodes.size() - 1;
-					LastNodeIndex = Nodes.size() - 1;
-				};
+				result = GrowLastRegion(SizeToChange - TotalSize) || AddRegion(SizeToChange - TotalSize);
 			};
 		}
 		return result;
 	}
 
-	template<typename Allocator>
-	void* DynamicAllocator<Allocator>::Allocate(SizeType size)
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	typename DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::NodeIDType DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::AddNode(MemoryHeaderBlockNode& NewNode)
 	{
-		void* resultPointer = nullptr;
-		if (size <= MinAllocSizeRequirement)
-			DYNAMIC_ALLOCATOR_REPORT("Allocation of small amount of memory from Dynamic Allocator, consider using another allocator.");
+		NodeIDType NewNodeID = InvalidNodeID;
+		if (FreeNodeIDsHead == InvalidNodeID)
+		{
+			// All IDs are taken, the max value of ID type is reserved for InvalidNodeID
+			if (Nodes.size() >= InvalidNodeID)
+				return InvalidNodeID;
+			Nodes.push_back(std::move(NewNode));
+			NewNodeID = Nodes.size() - 1;
+		}
+		else
+		{
+			NewNodeID = FreeNodeIDsHead;
+			FreeNodeIDsHead = Nodes.at(NewNodeID).NextNodeIndex;
+			FreeNodeIDsCount--;
+			Nodes.at(NewNodeID) = NewNode;
+		}
+		return NewNodeID;
+	}
 
-		if (size > FreeSpaceSize)
-			Resize(TotalSize + size);
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	void DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::ReleaseNode(NodeIDType NodeIndex)
+	{
+		NodeReference ReleasedNode = Nodes.at(NodeIndex);
+		ReleasedNode = MemoryHeaderBlockNode{};
+		ReleasedNode.NextNodeIndex = FreeNodeIDsHead;
+		FreeNodeIDsHead = NodeIndex;
+		FreeNodeIDsCount++;
+	}
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	bool DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::AddRegion(SizeType size)
+	{
+		size = FreeIndexType::RoundRegionSize(size);
+		if (size == 0 || size > std::numeric_limits<SizeType>::max() - TotalSize)
+			return false;
+
+		// Region gets extra bytes to align returned pointers by granularity of free block index
+		constexpr uint32 Granularity = FreeIndexType::Granularity;
+		if (size > std::numeric_limits<SizeType>::max() - (Granularity - 1))
+			return false;
+		size_t AllocationSize = RoundAllocationSize<InternalAllocator>((size_t)size + (Granularity - 1), HasRoundAllocationSize<InternalAllocator>{});
+		// Region takes the rest of rounded allocation if free block index accepts such size of region
+		SizeType RoundedSize = (SizeType)std::min<size_t>(AllocationSize - (Granularity - 1), std::numeric_limits<SizeType>::max() - TotalSize) & ~(SizeType)(Granularity - 1);
+		if (FreeIndexType::RoundRegionSize(RoundedSize) == RoundedSize)
+			size = RoundedSize;
+
+		// Region is carved into several nodes by buddy index, all of them must get IDs
+		size_t CarvedNodesCount = 0;
+		for (SizeType Offset = 0; Offset < size; CarvedNodesCount++)
+			Offset += FreeIndexType::GetCarveSize(size - Offset);
+		if (CarvedNodesCount > GetAvailableNodeIDsCount())
+			return false;
 
-		if (Nodes.size() > 0)
+		void* allocatedMemoryBlockForResize = InternalAllocator::Allocate(AllocationSize);
+		DYNAMIC_ALLOCATOR_ASSERT(allocatedMemoryBlockForResize && "Failed to allocated memory for Dynamic Allocator resize");
+		if (allocatedMemoryBlockForResize == nullptr)
+			return false;
+		// The first node starts HeaderSize bytes before aligned address
+		uint8* RegionMemory = (uint8*)allocatedMemoryBlockForResize;
+		if (Granularity > 1)
 		{
-			// Loop through nodes by using indexes for the array
-			NodeIDType BestNodeIDForAllocation = InvalidNodeID;
-			for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
-			{
-				MemoryHeaderBlockNode& NodeCandidateHeader = Nodes.at(nodeIndex);
-				// Check if Node is suitable for allocation
-				if (NodeCandidateHeader.Size >= size && NodeCandidateHeader.IsBlockFree == 1)
-				{
-					// 1 time stop...
-					if (BestNodeIDForAllocation == InvalidNodeID)
-						BestNodeIDForAllocation = nodeIndex;
+			uintptr_t AlignedPointer = ((uintptr_t)RegionMemory + OccupiedIndexType::HeaderSize + Granularity - 1) & ~(uintptr_t)(Granularity - 1);
+			RegionMemory = (uint8*)AlignedPointer - OccupiedIndexType::HeaderSize;
+		}
 
-					// If a candidate is better than current BestNode, make the candidate The Best
-					if (BestNodeIDForAllocation != InvalidNodeID
-						&& Nodes.at(BestNodeIDForAllocation).Size > NodeCandidateHeader.Size)
-					{
-						BestNodeIDForAllocation = nodeIndex;
-					};
-				};
+		// Reuse slot of released region
+		uint16 NewRegionID = InvalidRegionID;
+		for (uint32 regionIndex = 0; regionIndex < Regions.size(); regionIndex++)
+		{
+			if (Regions[regionIndex].Memory == nullptr)
+			{
+				NewRegionID = (uint16)regionIndex;
+				break;
+			}
+		}
+		if (NewRegionID == InvalidRegionID)
+		{
+			if (Regions.size() >= InvalidRegionID)
+			{
+				InternalAllocator::Deallocate(allocatedMemoryBlockForResize);
+				return false;
 			}
+			NewRegionID = (uint16)Regions.size();
+			Regions.emplace_back();
+		}
+		MemoryRegion& NewRegion = Regions[NewRegionID];
+		NewRegion.Memory = RegionMemory;
+		NewRegion.Size = size;
+		NewRegion.AllocatedMemory = allocatedMemoryBlockForResize;
+		Nodes.InsertRegion(NewRegion, NewRegionID);
+
+		// Carve region into nodes, each one is added at the end of the list
+		NodeIDType PrimaryNodeID = InvalidNodeID;
+		for (SizeType Offset = 0; Offset < size;)
+		{
+			SizeType CarveSize = FreeIndexType::GetCarveSize(size - Offset);
+			MemoryHeaderBlockNode NewReservedNode{};
+			NewReservedNode.IsNextNodeAdjacent = 0;
+			NewReservedNode.IsPrevNodeAdjacent = Offset != 0;
+			NewReservedNode.IsPrimaryAllocated = Offset == 0;
+			NewReservedNode.IsBlockFree = 1;
+			NewReservedNode.NodeMemory = (void*)(RegionMemory + Offset);
+			NewReservedNode.Size = CarveSize;
+			NewReservedNode.NextNodeIndex = InvalidNodeID;
+			NewReservedNode.PrevNodeIndex = LastNodeIndex;
+			NewReservedNode.RegionID = NewRegionID;
+			NodeIDType NewNodeID = AddNode(NewReservedNode);
+			FreeIndex.Insert(Nodes, NewNodeID);
 
-			if (BestNodeIDForAllocation == InvalidNodeID)
-				// Do a New Allocation for a block of memory
+			// Update data about the last node, list is empty if all memory was deallocated by previous resize
+			if (LastNodeIndex == InvalidNodeID)
 			{
-				DYNAMIC_ALLOCATOR_REPORT("No more space in Dynamic Allocator for allocation(Out of space/Fragmentation of memory blocks) \
-											| Dynamic Allocator must do resizing");
-				Resize(TotalSize + size);
-				BestNodeIDForAllocation = LastNodeIndex;
+				HeadNodeIndex = NewNodeID;
 			}
-			// IF we found the best-fitted node or resizing was made before this ^^^
-			if (BestNodeIDForAllocation != InvalidNodeID)
-			{
-				MemoryHeaderBlockNode& BestNode = Nodes.at(BestNodeIDForAllocation);
-				// Check if we can make a new memory node block from remained memory in this node
-				if (BestNode.Size > size && BestNode.Size - size >= MinAllocSizeRequirement)
-					// If we can, then
-				{
-					// Create a new node from remained memory
-					MemoryHeaderBlockNode NewNodeFromRemaindedMemoryInBestNode{};
-					NewNodeFromRemaindedMemoryInBestNode.IsNextNodeAdjacent = BestNode.IsNextNodeAdjacent;
-					NewNodeFromRemaindedMemoryInBestNode.NextNodeIndex = BestNode.NextNodeIndex;
-					NewNodeFromRemaindedMemoryInBestNode.IsBlockFree = 1;
-					NewNodeFromRemaindedMemoryInBestNode.NodeMemory = (void*)((uint8*)BestNode.NodeMemory + size);
-					NewNodeFromRemaindedMemoryInBestNode.Size = BestNode.Size - size;
-					NewNodeFromRemaindedMemoryInBestNode.IsPrimaryAllocated = 0;
-
-					NodeIDType NewNodeID = InvalidNodeID;
-
-					if (UseFreeBinNodesID == 0)
-					{
-						Nodes.push_back(std::move(NewNodeFromRemaindedMemoryInBestNode));
-						NewNodeID = Nodes.size() - 1;
-					}
-					else
-					{
-						DYNAMIC_ALLOCATOR_ASSERT(NodesFreeIdsBin.size() > 0);
-						NodeIDType FreeIndex = NodesFreeIdsBin.at(NodesFreeIdsBin.size() - 1);
-						std::swap(Nodes.at(FreeIndex), NewNodeFromRemaindedMemoryInBestNode);
-						NodesFreeIdsBin.pop_back();
-						NewNodeID = FreeIndex;
-						// If no more free indexes, uncheck this flag
-						if (NodesFreeIdsBin.size() == 0)
-							UseFreeBinNodesID = 0;
-					}
+			else
+			{
+				Nodes.at(LastNodeIndex).NextNodeIndex = NewNodeID;
+				Nodes.at(LastNodeIndex).IsNextNodeAdjacent = Offset != 0;
+			};
+			LastNodeIndex = NewNodeID;
 
-					DYNAMIC_ALLOCATOR_ASSERT(NewNodeID != InvalidNodeID);
+			if (Offset == 0)
+				PrimaryNodeID = NewNodeID;
+			Offset += CarveSize;
+		}
 
-					//If it's created at the end of the "list", update the last node index
-					if (LastNodeIndex == BestNodeIDForAllocation || LastNodeIndex == InvalidNodeID)
-						LastNodeIndex = NewNodeID;
+		NewRegion.PrimaryNodeIndex = PrimaryNodeID;
+		FreeSpaceSize += size;
+		TotalSize += size;
 
-					// Edit the best node while taking in mind of loosed memory block at the end
-					BestNode.IsNextNodeAdjacent = 1;
-					BestNode.IsBlockFree = 0;
-					BestNode.Size = size;
-					BestNode.NextNodeIndex = NewNodeID;
-				}
-				// else just use this node for allocation
-				else
-				{
-					BestNode.IsBlockFree = 0;
-				}
-				resultPointer = BestNode.NodeMemory;
-				FreeSpaceSize -= BestNode.Size;
-			}
+		// Occupied block index may not cover the memory(e.g. addresses beyond the page map)
+		if (!OccupiedIndex.InsertRegion(NewRegion, NewRegionID))
+		{
+			RemoveRegion(PrimaryNodeID);
+			return false;
 		}
+		return true;
+	}
 
-		return resultPointer;
-	};
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	bool DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::GrowLastRegion(SizeType size, std::true_type)
+	{
+		size = FreeIndexType::RoundRegionSize(size);
+		if (LastNodeIndex == InvalidNodeID || size == 0 || size > std::numeric_limits<SizeType>::max() - TotalSize)
+			return false;
+		const bool IsLastNodeFree = Nodes.at(LastNodeIndex).IsBlockFree == 1;
+		if (!IsLastNodeFree && GetAvailableNodeIDsCount() == 0)
+			return false;
+
+		const uint16 RegionID = Nodes.at(LastNodeIndex).RegionID;
+		MemoryRegion& Region = Regions.at(RegionID);
+		DYNAMIC_ALLOCATOR_ASSERT((uint8*)Nodes.at(LastNodeIndex).NodeMemory + Nodes.at(LastNodeIndex).Size == (uint8*)Region.Memory + Region.Size);
+		if (!InternalAllocator::Grow(Region.AllocatedMemory, size))
+			return false;
+		// Memory stays committed but unused if occupied block index can't cover it
+		MemoryRegion GrownRegion = Region;
+		GrownRegion.Size += size;
+		if (!OccupiedIndex.GrowRegion(GrownRegion, RegionID, Region.Size))
+			return false;
+
+		if (IsLastNodeFree)
+		{
+			FreeIndex.Remove(Nodes, LastNodeIndex);
+			Nodes.at(LastNodeIndex).Size += size;
+			FreeIndex.Insert(Nodes, LastNodeIndex);
+		}
+		else
+		{
+			MemoryHeaderBlockNode NewNode{};
+			NewNode.IsNextNodeAdjacent = 0;
+			NewNode.IsPrevNodeAdjacent = 1;
+			NewNode.IsPrimaryAllocated = 0;
+			NewNode.IsBlockFree = 1;
+			NewNode.NodeMemory = (void*)((uint8*)Region.Memory + Region.Size);
+			NewNode.Size = size;
+			NewNode.NextNodeIndex = InvalidNodeID;
+			NewNode.PrevNodeIndex = LastNodeIndex;
+			NewNode.RegionID = RegionID;
+			NodeIDType NewNodeID = AddNode(NewNode);
+			FreeIndex.Insert(Nodes, NewNodeID);
+
+			Nodes.at(LastNodeIndex).NextNodeIndex = NewNodeID;
+			Nodes.at(LastNodeIndex).IsNextNodeAdjacent = 1;
+			LastNodeIndex = NewNodeID;
+		}
 
+		Region.Size += size;
+		FreeSpaceSize += size;
+		TotalSize += size;
+		return true;
+	}
 
-	template<typename Allocator>
-	bool DynamicAllocator<Allocator>::Free(void* address)
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	bool DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::IsRegionFree(NodeIDType PrimaryNodeIndex) const
 	{
-		NodeIDType previousNodeIndex = InvalidNodeID;
-		for (NodeIDType currentNodeIndex = HeadNodeIndex; currentNodeIndex != InvalidNodeID; currentNodeIndex = Nodes.at(currentNodeIndex).NextNodeIndex)
+		for (NodeIDType nodeIndex = PrimaryNodeIndex;; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
 		{
-			if (Nodes.at(currentNodeIndex).NodeMemory == address)
-			{
-				MemoryHeaderBlockNode& DealocatedNode = Nodes.at(currentNodeIndex);
-				DealocatedNode.IsBlockFree = 1;
-				FreeSpaceSize += DealocatedNode.Size;
+			ConstNodeReference Node = Nodes.at(nodeIndex);
+			if (Node.IsBlockFree == 0)
+				return false;
+			if (Node.IsNextNodeAdjacent == 0)
+				return true;
+		}
+	}
 
-				// Check if the next to the freed node is free and adjacent(next in memory),
-				if (DealocatedNode.NextNodeIndex != InvalidNodeID &&
-					DealocatedNode.IsNextNodeAdjacent == 1 &&
-					Nodes.at(DealocatedNode.NextNodeIndex).IsBlockFree == 1)
-				{
-					// If it is, than add it's size(update other stuff) and make this(next) node as "empty"
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	typename DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::NodeIDType DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::RemoveRegion(NodeIDType PrimaryNodeIndex)
+	{
+		NodeReference PrimaryNode = Nodes.at(PrimaryNodeIndex);
+		DYNAMIC_ALLOCATOR_ASSERT(PrimaryNode.IsPrimaryAllocated == 1 && IsRegionFree(PrimaryNodeIndex));
 
-					// Update info about this node, add size of next node, set next node index...
-					uint32 NextBlockIndex = DealocatedNode.NextNodeIndex;
-					MemoryHeaderBlockNode& NextToDealocatedBlock = Nodes.at(NextBlockIndex);
-					DealocatedNode.IsNextNodeAdjacent = NextToDealocatedBlock.IsNextNodeAdjacent;
-					DealocatedNode.Size += NextToDealocatedBlock.Size;
-					DealocatedNode.NextNodeIndex = NextToDealocatedBlock.NextNodeIndex;
+		const uint16 FreedRegionID = PrimaryNode.RegionID;
+		MemoryRegion& FreedRegion = Regions.at(FreedRegionID);
+		OccupiedIndex.RemoveRegion(FreedRegion, FreedRegionID);
+		InternalAllocator::Deallocate(FreedRegion.AllocatedMemory);
 
-					// Make this adjacent node invalid
-					NextToDealocatedBlock = MemoryHeaderBlockNode{};
+		NodeIDType LastRegionNodeIndex = PrimaryNodeIndex;
+		while (Nodes.at(LastRegionNodeIndex).IsNextNodeAdjacent == 1)
+			LastRegionNodeIndex = Nodes.at(LastRegionNodeIndex).NextNodeIndex;
+		NodeIDType nextNodeIndex = Nodes.at(LastRegionNodeIndex).NextNodeIndex;
 
-					// If the next block is last, make this the last block
-					if (LastNodeIndex == NextBlockIndex)
-						LastNodeIndex = currentNodeIndex;
+		// Unlink nodes from the end of the region, so the unlinked node is always the last one in the region
+		for (NodeIDType nodeIndex = LastRegionNodeIndex; nodeIndex != InvalidNodeID;)
+		{
+			NodeReference FreedNode = Nodes.at(nodeIndex);
+			NodeIDType prevNodeIndex = FreedNode.IsPrevNodeAdjacent == 1 ? FreedNode.PrevNodeIndex : InvalidNodeID;
 
-					// Push this adjacent node index into the free node's index bin
-					NodesFreeIdsBin.push_back(NextBlockIndex);
-				};
+			FreeIndex.Remove(Nodes, nodeIndex);
+			FreeSpaceSize -= FreedNode.Size;
+			TotalSize -= FreedNode.Size;
 
-				// Check if the previous node is adjacent to this and is empty
-				if (previousNodeIndex != InvalidNodeID &&
-					Nodes.at(previousNodeIndex).IsNextNodeAdjacent == 1 &&
-					Nodes.at(previousNodeIndex).IsBlockFree == 1)
-				{
-					// If it is, then add to the previous node size of the current node, update other information
-					// and make the current node empty
-					MemoryHeaderBlockNode& PreviousNodeBlock = Nodes.at(previousNodeIndex);
-					PreviousNodeBlock.Size += DealocatedNode.Size;
-					PreviousNodeBlock.IsNextNodeAdjacent = DealocatedNode.IsNextNodeAdjacent;
-					PreviousNodeBlock.NextNodeIndex = DealocatedNode.NextNodeIndex;
+			UnlinkNode(nodeIndex);
+			ReleaseNode(nodeIndex);
+			nodeIndex = prevNodeIndex;
+		}
 
-					// If the current node is Last, make the previous node as last
-					if (LastNodeIndex == currentNodeIndex)
-					{
-						LastNodeIndex = previousNodeIndex;
-					}
+		// Packed nodes keep only offsets in the region, so its memory is dropped after all nodes are removed from indexes
+		Nodes.RemoveRegion(FreedRegion, FreedRegionID);
+		FreedRegion = MemoryRegion{};
+		return nextNodeIndex;
+	}
 
-					// Make this deallocated node invalid
-					DealocatedNode = MemoryHeaderBlockNode{};
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	void* DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::Allocate(SizeType size)
+	{
+		if (size <= MinAllocSizeRequirement)
+			DYNAMIC_ALLOCATOR_REPORT("Allocation of small amount of memory from Dynamic Allocator, consider using another allocator.");
 
-					// Push this deallocated node index into the free node's indexes bin
-					NodesFreeIdsBin.push_back(currentNodeIndex);
-				}
+		// Zero sized block would share its address with the next block
+		if (size == 0)
+			return nullptr;
 
-				// Check, if we have enough free indexes in the free bin to use,(and if yes, then) set dynamic allocator to use them
-				CheckAndSetFreeIdsUse();
+		// Space for the header of occupied block index goes in front of the allocation
+		if (size > std::numeric_limits<SizeType>::max() - OccupiedIndexType::HeaderSize)
+			return nullptr;
+		size += OccupiedIndexType::HeaderSize;
 
-				// MAYBE should delete node, if it's primarily allocated and is free and 
-				// No more chunks of memory from this node memory are in use
+		// Buddy system allocates only power of two blocks
+		size = FreeIndexType::RoundRequest(size);
+		if (size == 0)
+			return nullptr;
 
-				return true;
+		NodeIDType BestNodeIDForAllocation = FindFreeNode(size);
+		if (BestNodeIDForAllocation == InvalidNodeID)
+			return nullptr;
+
+		FreeIndex.Remove(Nodes, BestNodeIDForAllocation);
+		return OccupyNode(BestNodeIDForAllocation, size);
+	};
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	void* DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::AllocateAligned(SizeType size, SizeType alignment)
+	{
+		static_assert(std::is_base_of<GeneralBlockRules, FreeIndexType>::value, "Aligned allocation needs free block index which splits blocks at any offset");
+
+		if (size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > MaxAllocationAlignment)
+			return nullptr;
+
+		// Leading padding is at least MinAllocSizeRequirement bytes to become a free block, so the block is searched with room for it
+		const SizeType PaddingReserve = MinAllocSizeRequirement + alignment - 1;
+		if (size > std::numeric_limits<SizeType>::max() - OccupiedIndexType::HeaderSize)
+			return nullptr;
+		size = FreeIndexType::RoundRequest(size + OccupiedIndexType::HeaderSize);
+		if (size == 0 || size > std::numeric_limits<SizeType>::max() - PaddingReserve)
+			return nullptr;
+
+		NodeIDType BestNodeIDForAllocation = FindFreeNode(size + PaddingReserve);
+		if (BestNodeIDForAllocation == InvalidNodeID)
+			return nullptr;
+		FreeIndex.Remove(Nodes, BestNodeIDForAllocation);
+
+		// Returned pointer goes HeaderSize bytes after the start of the node
+		uintptr_t UnalignedPointer = (uintptr_t)(uint8*)Nodes.at(BestNodeIDForAllocation).NodeMemory + OccupiedIndexType::HeaderSize;
+		SizeType Padding = (SizeType)(((UnalignedPointer + alignment - 1) & ~(uintptr_t)(alignment - 1)) - UnalignedPointer);
+		if (Padding != 0 && Padding < MinAllocSizeRequirement)
+			Padding += (MinAllocSizeRequirement - Padding + alignment - 1) & ~(alignment - 1);
+
+		if (Padding != 0)
+		{
+			// Node keeps the padding and stays free(so primary node of the region doesn't change), allocation goes to the node after it
+			NodeIDType AlignedNodeID = SplitNode(BestNodeIDForAllocation, Padding);
+			FreeIndex.Insert(Nodes, BestNodeIDForAllocation);
+			if (AlignedNodeID == InvalidNodeID)
+				return nullptr;
+			BestNodeIDForAllocation = AlignedNodeID;
+		}
+		return OccupyNode(BestNodeIDForAllocation, size);
+	};
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	typename DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::NodeIDType DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::FindFreeNode(SizeType size)
+	{
+		// Total size after growing must fit into the size type, wrapped sum would make Resize shrink the allocator
+		const bool CanGrow = size <= std::numeric_limits<SizeType>::max() - TotalSize;
+		if (size > FreeSpaceSize && CanGrow)
+			Resize(TotalSize + size);
+
+		if (Nodes.size() == 0)
+			return InvalidNodeID;
+
+		NodeIDType BestNodeIDForAllocation = FreeIndex.Find(Nodes, HeadNodeIndex, size);
+		if (BestNodeIDForAllocation == InvalidNodeID)
+			// Do a New Allocation for a block of memory
+		{
+			DYNAMIC_ALLOCATOR_REPORT("No more space in Dynamic Allocator for allocation(Out of space/Fragmentation of memory blocks) \
+										| Dynamic Allocator must do resizing");
+			if (CanGrow && Resize(TotalSize + size))
+				BestNodeIDForAllocation = FreeIndex.Find(Nodes, HeadNodeIndex, size);
+		}
+		return BestNodeIDForAllocation;
+	}
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	typename DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::NodeIDType DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::SplitNode(NodeIDType NodeIndex, SizeType KeptSize)
+	{
+		// Create a new node from remained memory
+		MemoryHeaderBlockNode NewNodeFromRemaindedMemory{};
+		{
+			ConstNodeReference KeptNode = Nodes.at(NodeIndex);
+			NewNodeFromRemaindedMemory.IsNextNodeAdjacent = KeptNode.IsNextNodeAdjacent;
+			NewNodeFromRemaindedMemory.NextNodeIndex = KeptNode.NextNodeIndex;
+			NewNodeFromRemaindedMemory.PrevNodeIndex = NodeIndex;
+			NewNodeFromRemaindedMemory.IsPrevNodeAdjacent = 1;
+			NewNodeFromRemaindedMemory.IsBlockFree = 1;
+			NewNodeFromRemaindedMemory.NodeMemory = (void*)((uint8*)KeptNode.NodeMemory + KeptSize);
+			NewNodeFromRemaindedMemory.Size = KeptNode.Size - KeptSize;
+			NewNodeFromRemaindedMemory.IsPrimaryAllocated = 0;
+			NewNodeFromRemaindedMemory.RegionID = KeptNode.RegionID;
+		}
+
+		NodeIDType NewNodeID = AddNode(NewNodeFromRemaindedMemory);
+		if (NewNodeID == InvalidNodeID)
+			return InvalidNodeID;
+		// Growth of the nodes array may move the kept node, so it's taken after the new node is added
+		NodeReference KeptNode = Nodes.at(NodeIndex);
+
+		//If it's created at the end of the "list", update the last node index
+		if (LastNodeIndex == NodeIndex || LastNodeIndex == InvalidNodeID)
+			LastNodeIndex = NewNodeID;
+		else
+			Nodes.at(KeptNode.NextNodeIndex).PrevNodeIndex = NewNodeID;
+
+		// Edit the kept node while taking in mind of loosed memory block at the end
+		KeptNode.IsNextNodeAdjacent = 1;
+		KeptNode.Size = KeptSize;
+		KeptNode.NextNodeIndex = NewNodeID;
+		OccupiedIndex.Split(Nodes, NodeIndex, NewNodeID);
+		return NewNodeID;
+	}
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	void* DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::OccupyNode(NodeIDType NodeIndex, SizeType size)
+	{
+		// Make a new memory node block from remained memory in this node while index allows to split it
+		// (general index splits once, buddy index halves the block down to the size)
+		for (SizeType KeptSize = FreeIndexType::GetSplitSize(Nodes.at(NodeIndex).Size, size); KeptSize < Nodes.at(NodeIndex).Size;
+			KeptSize = FreeIndexType::GetSplitSize(Nodes.at(NodeIndex).Size, size))
+		{
+			NodeIDType NewNodeID = SplitNode(NodeIndex, KeptSize);
+			// Out of node IDs, remained memory stays in the allocation
+			if (NewNodeID == InvalidNodeID)
+				break;
+			FreeIndex.Insert(Nodes, NewNodeID);
+		}
+		NodeReference OccupiedNode = Nodes.at(NodeIndex);
+		OccupiedNode.IsBlockFree = 0;
+		FreeSpaceSize -= OccupiedNode.Size;
+		OccupiedIndex.Insert(Nodes, NodeIndex);
+		return (void*)((uint8*)OccupiedNode.NodeMemory + OccupiedIndexType::HeaderSize);
+	}
+
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	bool DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::Free(void* address)
+	{
+		if (address == nullptr)
+		{
+			return false;
+		}
+
+		NodeIDType currentNodeIndex = OccupiedIndex.Find(Nodes, address);
+		if (currentNodeIndex == InvalidNodeID)
+		{
+			return false;
+		}
+		OccupiedIndex.Remove(Nodes, currentNodeIndex);
+
+		DYNAMIC_ALLOCATOR_ASSERT(Nodes.at(currentNodeIndex).IsBlockFree == 0);
+		Nodes.at(currentNodeIndex).IsBlockFree = 1;
+		FreeSpaceSize += Nodes.at(currentNodeIndex).Size;
+
+		// Memory of the freed node and merged neighbors which weren't big enough to give their pages back to the system
+		uintptr_t UnreleasedBegin = (uintptr_t)(uint8*)Nodes.at(currentNodeIndex).NodeMemory;
+		uintptr_t UnreleasedEnd = UnreleasedBegin + Nodes.at(currentNodeIndex).Size;
+
+		// Merge with free adjacent nodes while index allows it(buddy blocks merge level by level)
+		for (bool IsMerged = true; IsMerged;)
+		{
+			IsMerged = false;
+			NodeReference DealocatedNode = Nodes.at(currentNodeIndex);
+			const MemoryRegion& DealocatedNodeRegion = Regions.at(DealocatedNode.RegionID);
+
+			// Check if the next to the freed node is free and adjacent(next in memory),
+			if (DealocatedNode.NextNodeIndex != InvalidNodeID &&
+				DealocatedNode.IsNextNodeAdjacent == 1 &&
+				Nodes.at(DealocatedNode.NextNodeIndex).IsBlockFree == 1 &&
+				FreeIndex.CanMerge(DealocatedNode, Nodes.at(DealocatedNode.NextNodeIndex), DealocatedNodeRegion))
+			{
+				// If it is, than add it's size(update other stuff) and make this(next) node as "empty"
+
+				// Update info about this node, add size of next node, set next node index...
+				NodeIDType NextBlockIndex = DealocatedNode.NextNodeIndex;
+				NodeReference NextToDealocatedBlock = Nodes.at(NextBlockIndex);
+				FreeIndex.Remove(Nodes, NextBlockIndex);
+				if (NextToDealocatedBlock.Size < ReleaseMinBlockSize)
+					UnreleasedEnd = (uintptr_t)(uint8*)NextToDealocatedBlock.NodeMemory + NextToDealocatedBlock.Size;
+				DealocatedNode.Size += NextToDealocatedBlock.Size;
+				OccupiedIndex.Merge(Nodes, currentNodeIndex, NextBlockIndex);
+				UnlinkNode(NextBlockIndex);
+
+				// Make this adjacent node invalid, its ID is reused by the next added node
+				ReleaseNode(NextBlockIndex);
+				IsMerged = true;
+			};
+
+			// Check if the previous node is adjacent to this and is empty
+			if (DealocatedNode.PrevNodeIndex != InvalidNodeID &&
+				DealocatedNode.IsPrevNodeAdjacent == 1 &&
+				Nodes.at(DealocatedNode.PrevNodeIndex).IsBlockFree == 1 &&
+				FreeIndex.CanMerge(Nodes.at(DealocatedNode.PrevNodeIndex), DealocatedNode, DealocatedNodeRegion))
+			{
+				// If it is, then add to the previous node size of the current node, update other information
+				// and make the current node empty
+				NodeIDType previousNodeIndex = DealocatedNode.PrevNodeIndex;
+				NodeReference PreviousNodeBlock = Nodes.at(previousNodeIndex);
+				FreeIndex.Remove(Nodes, previousNodeIndex);
+				if (PreviousNodeBlock.Size < ReleaseMinBlockSize)
+					UnreleasedBegin = (uintptr_t)(uint8*)PreviousNodeBlock.NodeMemory;
+				PreviousNodeBlock.Size += DealocatedNode.Size;
+				OccupiedIndex.Merge(Nodes, previousNodeIndex, currentNodeIndex);
+				UnlinkNode(currentNodeIndex);
+
+				// Make this deallocated node invalid, its ID is reused by the next added node
+				ReleaseNode(currentNodeIndex);
+				currentNodeIndex = previousNodeIndex;
+				IsMerged = true;
 			}
-			previousNodeIndex = currentNodeIndex;
-		};
-		return false;
+		}
+		FreeIndex.Insert(Nodes, currentNodeIndex);
+		ReleaseFreeNode(currentNodeIndex, UnreleasedBegin, UnreleasedEnd, HasRelease<InternalAllocator>{});
+
+#if DYNAMIC_ALLOCATOR_AUTO_TRIM == 1
+		// Valid nodes dropped below low watermark after a burst
+		if (Nodes.size() >= AutoCompactMinNodes && (Nodes.size() - FreeNodeIDsCount) * MetadataLowWatermarkDivisor < Nodes.size())
+			TrimMetadata();
+#endif
+#if DYNAMIC_ALLOCATOR_AUTO_COMPACT == 1
+		if (Nodes.size() >= AutoCompactMinNodes && FreeNodeIDsCount > Nodes.size() / 2)
+			CompactMetadata();
+#endif
+
+		// MAYBE should delete node, if it's primarily allocated and is free and 
+		// No more chunks of memory from this node memory are in use
+
+		return true;
 	}
 
 #if DYNAMIC_ALLOCATOR_STATS == 1
-	template<typename Allocator>
-	std::string DynamicAllocator<Allocator>::GetAllocatorStats() const
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	std::string DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::GetAllocatorStats() const
 	{
 		std::stringstream result{};
 		result << "\n Dynamic Allocator stats: _----------_\n DynamicAllocator address: ";
@@ -504,18 +3482,21 @@ namespace harz
 		result << "\n --------\n Nodes: ";
 		for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
 		{
-			auto& NodeRef = Nodes.at(nodeIndex);
+			ConstNodeReference NodeRef = Nodes.at(nodeIndex);
 			result << " ID[" << nodeIndex << "] size[" << NodeRef.Size << ']' << std::boolalpha << " isFree[" << (bool)NodeRef.IsBlockFree << ']';
 			result << " isPrimarlyAllocated[" << (bool)NodeRef.IsPrimaryAllocated << ']' << " NextNodeID[" << NodeRef.NextNodeIndex << ']';
-			result << " isNextNodeAdjacent[" << (bool)NodeRef.IsNextNodeAdjacent << ']' << " NodeAddress[" << NodeRef.NodeMemory << ']';
+			result << " isNextNodeAdjacent[" << (bool)NodeRef.IsNextNodeAdjacent << ']' << " PrevNodeID[" << NodeRef.PrevNodeIndex << ']';
+			result << " isPrevNodeAdjacent[" << (bool)NodeRef.IsPrevNodeAdjacent << ']' << " NodeAddress[" << (const void*)NodeRef.NodeMemory << ']';
+			result << " RegionID[" << NodeRef.RegionID << ']';
 		}
 		result << "\n ------- \n";
-		if (NodesFreeIdsBin.size() > 0)
+		result << " Metadata size: " << GetMetadataSize() << " bytes, node slots: " << Nodes.size() << ", invalid nodes: " << FreeNodeIDsCount << '\n';
+		if (FreeNodeIDsHead != InvalidNodeID)
 		{
 			result << '\n' << " FREE IDS: |";
-			for (uint32 index = 0; index < NodesFreeIdsBin.size(); index++)
+			for (NodeIDType nodeIndex = FreeNodeIDsHead; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
 			{
-				result << NodesFreeIdsBin[index] << '|';
+				result << nodeIndex << '|';
 			}
 		}
 		else
@@ -527,59 +3508,171 @@ namespace harz
 	}
 #endif
 
-	template<typename Allocator>
-	void DynamicAllocator<Allocator>::Clear()
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	void DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::UnlinkNode(NodeIDType NodeIndex)
 	{
-		for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
+		NodeReference UnlinkedNode = Nodes.at(NodeIndex);
+
+		// Memory of unlinked node is either merged into the previous node or is a whole primary block which is adjacent to nothing,
+		// so the previous node takes over adjacency of unlinked node's end and the next node's adjacency stays the same
+		if (UnlinkedNode.PrevNodeIndex != InvalidNodeID)
 		{
-			auto& Node = Nodes.at(nodeIndex);
-			if (Node.IsPrimaryAllocated == 1)
+			NodeReference PreviousNode = Nodes.at(UnlinkedNode.PrevNodeIndex);
+			PreviousNode.NextNodeIndex = UnlinkedNode.NextNodeIndex;
+			PreviousNode.IsNextNodeAdjacent = UnlinkedNode.IsNextNodeAdjacent;
+		}
+		else
+		{
+			HeadNodeIndex = UnlinkedNode.NextNodeIndex;
+		}
+
+		if (UnlinkedNode.NextNodeIndex != InvalidNodeID)
+		{
+			NodeReference NextNode = Nodes.at(UnlinkedNode.NextNodeIndex);
+			NextNode.PrevNodeIndex = UnlinkedNode.PrevNodeIndex;
+		}
+		else
+		{
+			LastNodeIndex = UnlinkedNode.PrevNodeIndex;
+		}
+
+		UnlinkedNode.NextNodeIndex = InvalidNodeID;
+		UnlinkedNode.PrevNodeIndex = InvalidNodeID;
+	}
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	void DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::Clear()
+	{
+		for (const MemoryRegion& Region : Regions)
+		{
+			if (Region.Memory != nullptr)
 			{
-				InternalAllocator::Deallocate(Node.NodeMemory);
+				InternalAllocator::Deallocate(Region.AllocatedMemory);
 			}
 		};
 
 		Nodes.clear();
-		NodesFreeIdsBin.clear();
+		FreeNodeIDsHead = InvalidNodeID;
+		FreeNodeIDsCount = 0;
+		Regions.clear();
+		OccupiedIndex.Clear();
+		FreeIndex.Clear();
 		HeadNodeIndex = InvalidNodeID;
 		LastNodeIndex = InvalidNodeID;
 		FreeSpaceSize = 0;
 		TotalSize = 0;
-		UseFreeBinNodesID = 0;
 	};
 
-	template<typename Allocator>
-	MemoryHeaderBlockNode DynamicAllocator<Allocator>::GetNodeMetadata(MemPtr nodeMemory)
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	void DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::RebuildMetadata(bool ReleaseMemory)
 	{
-		for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
+		NodeStorageType CompactedNodes{};
+		CompactedNodes.reserve((uint32)(Nodes.size() - FreeNodeIDsCount));
+		for (uint32 regionIndex = 0; regionIndex < Regions.size(); regionIndex++)
 		{
-			if (Nodes.at(nodeIndex).NodeMemory == nodeMemory)
-				return Nodes.at(nodeIndex);
-		};
+			if (Regions[regionIndex].Memory != nullptr)
+				CompactedNodes.InsertRegion(Regions[regionIndex], (uint16)regionIndex);
+		}
+
+		// Node gets ID of its position in the list
+		NodeIDType CompactedNodeIndex = 0;
+		for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex, CompactedNodeIndex++)
+		{
+			MemoryHeaderBlockNode Node = Nodes.at(nodeIndex);
+			Node.PrevNodeIndex = CompactedNodeIndex > 0 ? CompactedNodeIndex - 1 : InvalidNodeID;
+			Node.NextNodeIndex = Node.NextNodeIndex != InvalidNodeID ? CompactedNodeIndex + 1 : InvalidNodeID;
+			if (Node.IsPrimaryAllocated == 1)
+				Regions.at(Node.RegionID).PrimaryNodeIndex = CompactedNodeIndex;
+			CompactedNodes.push_back(Node);
+		}
+
+		Nodes = std::move(CompactedNodes);
+		HeadNodeIndex = CompactedNodeIndex > 0 ? 0 : InvalidNodeID;
+		LastNodeIndex = CompactedNodeIndex > 0 ? CompactedNodeIndex - 1 : InvalidNodeID;
+		FreeNodeIDsHead = InvalidNodeID;
+		FreeNodeIDsCount = 0;
+
+		FreeIndex.Clear();
+		OccupiedIndex.Clear();
+		if (ReleaseMemory)
+		{
+			FreeIndex.Trim();
+			OccupiedIndex.Trim();
+			// Slots of released regions at the end aren't needed
+			while (!Regions.empty() && Regions.back().Memory == nullptr)
+				Regions.pop_back();
+			Regions.shrink_to_fit();
+		}
+		for (uint32 regionIndex = 0; regionIndex < Regions.size(); regionIndex++)
+		{
+			if (Regions[regionIndex].Memory != nullptr)
+				OccupiedIndex.InsertRegion(Regions[regionIndex], (uint16)regionIndex);
+		}
+		for (NodeIDType nodeIndex = 0; nodeIndex < CompactedNodeIndex; nodeIndex++)
+		{
+			if (Nodes.at(nodeIndex).IsBlockFree == 1)
+				FreeIndex.Insert(Nodes, nodeIndex);
+			else
+				OccupiedIndex.Insert(Nodes, nodeIndex);
+		}
+	}
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	void DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::ReleaseFreeNode(NodeIDType NodeIndex, uintptr_t UnreleasedBegin, uintptr_t UnreleasedEnd, std::true_type)
+	{
+		ConstNodeReference FreeNode = Nodes.at(NodeIndex);
+		if (FreeNode.Size < ReleaseMinBlockSize)
+			return;
+
+		// Big neighbors gave their pages back when they were freed, except pages shared with the unreleased memory.
+		// Header of the free block stays
+		const uintptr_t Granularity = InternalAllocator::GetReleaseGranularity();
+		uintptr_t BlockBegin = (uintptr_t)(uint8*)FreeNode.NodeMemory + OccupiedIndexType::HeaderSize;
+		uintptr_t BlockEnd = (uintptr_t)(uint8*)FreeNode.NodeMemory + FreeNode.Size;
+		uintptr_t ReleaseBegin = UnreleasedBegin > BlockBegin + Granularity ? UnreleasedBegin - Granularity : BlockBegin;
+		uintptr_t ReleaseEnd = UnreleasedEnd + Granularity < BlockEnd ? UnreleasedEnd + Granularity : BlockEnd;
+		InternalAllocator::Release((void*)ReleaseBegin, ReleaseEnd - ReleaseBegin);
+	}
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	void* DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::FindAllocation(const void* address) const
+	{
+		if (address == nullptr)
+			return nullptr;
+
+		NodeIDType nodeIndex = OccupiedIndex.FindContaining(Nodes, HeadNodeIndex, address);
+		if (nodeIndex == InvalidNodeID)
+			return nullptr;
+
+		ConstNodeReference Node = Nodes.at(nodeIndex);
+		void* allocation = (void*)((uint8*)Node.NodeMemory + OccupiedIndexType::HeaderSize);
+		// Header of occupied block index is not a part of the allocation
+		if (Node.IsBlockFree == 1 || (const uint8*)address < (const uint8*)allocation)
+			return nullptr;
+		return allocation;
+	}
+
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	typename DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::MemoryHeaderBlockNode DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::GetNodeMetadata(MemPtr nodeMemory)
+	{
+		NodeIDType nodeIndex = OccupiedIndex.Find(Nodes, nodeMemory);
+		if (nodeIndex != InvalidNodeID)
+			return Nodes.at(nodeIndex);
 		return {};
 	}
 
-	template<typename Allocator>
-	uint32 DynamicAllocator<Allocator>::GetFreeNodeIndex()
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	typename DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::NodeIDType DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::GetFreeNodeIndex()
 	{
-		for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
-		{
-			if (Nodes.at(nodeIndex).IsBlockFree == 1)
-				return nodeIndex;
-		};
-		return 0;
+		return FreeIndex.First(Nodes, HeadNodeIndex);
 	}
 
-	template<typename Allocator>
-	uint32 DynamicAllocator<Allocator>::GetNodeSize(MemPtr nodeMemory)
+	template<typename Allocator, typename FreeBlockIndex, typename OccupiedBlockIndex, typename NodeStorage, typename SizeT, typename NodeIDT>
+	typename DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::SizeType DynamicAllocator<Allocator, FreeBlockIndex, OccupiedBlockIndex, NodeStorage, SizeT, NodeIDT>::GetNodeSize(MemPtr nodeMemory)
 	{
-		for (NodeIDType nodeIndex = HeadNodeIndex; nodeIndex != InvalidNodeID; nodeIndex = Nodes.at(nodeIndex).NextNodeIndex)
-		{
-			if (Nodes.at(nodeIndex).NodeMemory == nodeMemory)
-			{
-				return Nodes.at(nodeIndex).Size;
-			}
-		};
+		NodeIDType nodeIndex = OccupiedIndex.Find(Nodes, nodeMemory);
+		if (nodeIndex != InvalidNodeID)
+			return Nodes.at(nodeIndex).Size;
 		return 0;
 	}
 };
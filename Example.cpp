@@ -16,6 +16,11 @@ int main()
 	IntArr[18] = 163456;
 	std::cout << "Here our int[18]: " << IntArr[18] << '\n';
 
+	// Allocate buffer aligned to the cache line(e.g. for SIMD loads), it's freed as any other allocation
+	auto* AlignedAlloc = DynamicAllocator.AllocateAligned(sizeof(float) * 64, 64);
+	std::cout << "Aligned allocation address: " << AlignedAlloc << '\n';
+	DynamicAllocator.Free(AlignedAlloc);
+
 	// Make loop of allocations/deallocations(frees)
 	const int DynAllocIters = 10000;
 	for (int i = 0; i < DynAllocIters; i++)
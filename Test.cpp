@@ -0,0 +1,1135 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+#define DYNAMIC_ALLOCATOR_STATS 1
+#include "DynamicAllocator.h"
+
+// Self-checking tests of the allocator, exit code is non-zero if any of them fails: g++ -std=c++14 -O1 Test.cpp
+// Metadata is checked through the text of GetAllocatorStats, so tests need no access to internals of the allocator
+
+using namespace harz;
+
+// Allocation made by a test, its memory is filled with the tag
+struct TestAllocation
+{
+	uint8* Memory = nullptr;
+	size_t Size = 0;
+	uint8 Tag = 0;
+};
+
+// Fields of a node printed by GetAllocatorStats, e.g. "size" -> "256"
+using StatsNode = std::map<std::string, std::string>;
+
+size_t GetField(const StatsNode& Node, const char* Key)
+{
+	auto FieldIt = Node.find(Key);
+	if (FieldIt == Node.end())
+		return 0;
+	if (FieldIt->second == "true" || FieldIt->second == "false")
+		return FieldIt->second == "true";
+	return (size_t)std::stoull(FieldIt->second, nullptr, FieldIt->second.compare(0, 2, "0x") == 0 ? 16 : 10);
+}
+
+// Nodes in the order of the list and IDs of invalid nodes from GetAllocatorStats
+void ParseStats(const std::string& Stats, std::vector<StatsNode>& Nodes, std::vector<size_t>& FreeIDs)
+{
+	const size_t NodesBegin = Stats.find("Nodes:");
+	const size_t NodesEnd = Stats.find("\n -------", NodesBegin);
+	for (size_t Open = Stats.find('[', NodesBegin); Open < NodesEnd; Open = Stats.find('[', Open + 1))
+	{
+		size_t KeyBegin = Open;
+		while (KeyBegin > 0 && std::isalpha((unsigned char)Stats[KeyBegin - 1]))
+			KeyBegin--;
+		const std::string Key = Stats.substr(KeyBegin, Open - KeyBegin);
+		if (Key == "ID")
+			Nodes.emplace_back();
+		Nodes.back()[Key] = Stats.substr(Open + 1, Stats.find(']', Open) - Open - 1);
+	}
+
+	const size_t FreeIDsBegin = Stats.find("FREE IDS: |");
+	if (FreeIDsBegin == std::string::npos)
+		return;
+	std::stringstream FreeIDsList{ Stats.substr(FreeIDsBegin + 11, Stats.find('\n', FreeIDsBegin) - FreeIDsBegin - 11) };
+	for (std::string FreeID; std::getline(FreeIDsList, FreeID, '|');)
+		FreeIDs.push_back(std::stoull(FreeID));
+}
+
+bool IsAllocationIntact(const TestAllocation& Allocation)
+{
+	for (size_t byteIndex = 0; byteIndex < Allocation.Size; byteIndex++)
+	{
+		if (Allocation.Memory[byteIndex] != Allocation.Tag)
+			return false;
+	}
+	return true;
+}
+
+// Check links and adjacency of nodes, sizes, IDs of invalid nodes and that every occupied node holds exactly one of the allocations.
+// Coalesced allocator never keeps two adjacent free nodes. Return description of the first broken invariant or empty string
+template<typename AllocatorType>
+std::string CheckMetadata(const AllocatorType& Allocator, const std::vector<TestAllocation>& Allocations, bool IsCoalesced = true)
+{
+	std::vector<StatsNode> Nodes{};
+	std::vector<size_t> FreeIDs{};
+	ParseStats(Allocator.GetAllocatorStats(), Nodes, FreeIDs);
+
+	std::set<size_t> NodeIDs{};
+	std::vector<std::pair<uintptr_t, size_t>> OccupiedNodes{};
+	size_t TotalSize = 0;
+	size_t FreeSpaceSize = 0;
+	for (size_t nodeIndex = 0; nodeIndex < Nodes.size(); nodeIndex++)
+	{
+		const StatsNode& Node = Nodes[nodeIndex];
+		const size_t ID = GetField(Node, "ID");
+		const size_t Size = GetField(Node, "size");
+		const uintptr_t Address = GetField(Node, "NodeAddress");
+		if (!NodeIDs.insert(ID).second)
+			return "node " + std::to_string(ID) + " is in the list twice";
+		if (Size == 0)
+			return "node " + std::to_string(ID) + " has zero size";
+		// Previous node of the head and next node of the last node are both invalid
+		if (Node.count("PrevNodeID") != 0 && GetField(Node, "PrevNodeID") != (nodeIndex > 0 ? GetField(Nodes[nodeIndex - 1], "ID") : GetField(Nodes.back(), "NextNodeID")))
+			return "node " + std::to_string(ID) + " has broken link to the previous node";
+
+		if (nodeIndex + 1 < Nodes.size())
+		{
+			const StatsNode& NextNode = Nodes[nodeIndex + 1];
+			const bool IsNextNodeAdjacent = GetField(Node, "isNextNodeAdjacent") == 1;
+			if (NextNode.count("isPrevNodeAdjacent") != 0 && (GetField(NextNode, "isPrevNodeAdjacent") == 1) != IsNextNodeAdjacent)
+				return "node " + std::to_string(ID) + " and the next node disagree on adjacency";
+			if (IsNextNodeAdjacent && Address + Size != GetField(NextNode, "NodeAddress"))
+				return "node " + std::to_string(ID) + " is marked adjacent to the next node, but there is a gap";
+			if (IsCoalesced && IsNextNodeAdjacent && GetField(Node, "isFree") == 1 && GetField(NextNode, "isFree") == 1)
+				return "node " + std::to_string(ID) + " and the next node are adjacent free nodes";
+		}
+		else if (GetField(Node, "isNextNodeAdjacent") == 1)
+		{
+			return "last node is marked adjacent to the next node";
+		}
+
+		TotalSize += Size;
+		if (GetField(Node, "isFree") == 1)
+			FreeSpaceSize += Size;
+		else
+			OccupiedNodes.emplace_back(Address, Size);
+	}
+	if (TotalSize != (size_t)Allocator.GetTotalSize() || FreeSpaceSize != (size_t)Allocator.GetFreeSpaceSize())
+		return "sizes of nodes don't add up to total size and free space size";
+
+	std::set<size_t> UniqueFreeIDs{};
+	for (size_t FreeID : FreeIDs)
+	{
+		if (NodeIDs.count(FreeID) != 0 || !UniqueFreeIDs.insert(FreeID).second)
+			return "ID of invalid node " + std::to_string(FreeID) + " is used twice";
+	}
+
+	// Header of boundary tags may precede the allocation, so the allocation is anywhere inside of its node
+	if (OccupiedNodes.size() != Allocations.size())
+		return std::to_string(OccupiedNodes.size()) + " occupied nodes for " + std::to_string(Allocations.size()) + " allocations";
+	std::sort(OccupiedNodes.begin(), OccupiedNodes.end());
+	std::vector<uint8> IsNodeTaken(OccupiedNodes.size(), 0);
+	for (const TestAllocation& Allocation : Allocations)
+	{
+		auto NodeIt = std::upper_bound(OccupiedNodes.begin(), OccupiedNodes.end(), std::make_pair((uintptr_t)Allocation.Memory, SIZE_MAX));
+		if (NodeIt == OccupiedNodes.begin() || (uintptr_t)Allocation.Memory + Allocation.Size > (--NodeIt)->first + NodeIt->second
+			|| IsNodeTaken[NodeIt - OccupiedNodes.begin()]++ != 0)
+			return "allocation of " + std::to_string(Allocation.Size) + " bytes isn't inside of its own occupied node";
+	}
+	return {};
+}
+
+// Random allocate/free/resize steps, metadata and memory of all allocations are checked every CheckPeriod steps
+template<typename AllocatorType>
+std::string RunRandomSteps(uint32 Seed, bool IsCoalesced = true, MetadataReservation Reservation = MetadataReservation::Eager)
+{
+	const int StepsCount = 20000;
+	const int CheckPeriod = 100;
+	const uint32 BaseSize = 64 * 1024;
+
+	AllocatorType Allocator{ BaseSize, 256, Reservation };
+	std::mt19937 Random{ Seed };
+	std::vector<TestAllocation> Allocations{};
+	std::string Failure{};
+
+	for (int step = 0; step < StepsCount && Failure.empty(); step++)
+	{
+		const uint32 Action = Random() % 1000;
+		if (Action < 520 || Allocations.empty())
+		{
+			TestAllocation Allocation{};
+			Allocation.Size = Random() % 16 == 0 ? Random() % 32768 + 1 : Random() % 512 + 1;
+			Allocation.Tag = (uint8)Random();
+			Allocation.Memory = (uint8*)Allocator.Allocate(Allocation.Size);
+			if (Allocation.Memory == nullptr)
+				return "allocation failed at step " + std::to_string(step);
+			std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+			Allocations.push_back(Allocation);
+		}
+		else if (Action < 994)
+		{
+			const size_t allocationIndex = Random() % Allocations.size();
+			const TestAllocation Allocation = Allocations[allocationIndex];
+			if (!IsAllocationIntact(Allocation))
+				return "memory of allocation is overwritten at step " + std::to_string(step);
+			if (!Allocator.Free(Allocation.Memory) || Allocator.Free(Allocation.Memory))
+				return "free failed or double free succeeded at step " + std::to_string(step);
+			Allocations[allocationIndex] = Allocations.back();
+			Allocations.pop_back();
+		}
+		else if (Action < 997)
+		{
+			// Shrinking releases only free regions, so it may fail
+			Allocator.Resize(BaseSize);
+		}
+		else
+		{
+			if (!Allocator.Resize(Allocator.GetTotalSize() + BaseSize))
+				return "resize failed at step " + std::to_string(step);
+		}
+
+		if (step % CheckPeriod == 0)
+		{
+			Failure = CheckMetadata(Allocator, Allocations, IsCoalesced);
+			for (int lookupIndex = 0; lookupIndex < 8 && Failure.empty() && !Allocations.empty(); lookupIndex++)
+			{
+				const TestAllocation& Allocation = Allocations[Random() % Allocations.size()];
+				if (Allocator.FindAllocation(Allocation.Memory + Random() % Allocation.Size) != Allocation.Memory)
+					Failure = "interior pointer isn't found";
+			}
+			for (const TestAllocation& Allocation : Allocations)
+			{
+				if (!IsAllocationIntact(Allocation))
+					Failure = "memory of allocation is overwritten";
+			}
+			if (!Failure.empty())
+				Failure += " at step " + std::to_string(step);
+		}
+	}
+
+	for (const TestAllocation& Allocation : Allocations)
+	{
+		if (Failure.empty() && (!IsAllocationIntact(Allocation) || !Allocator.Free(Allocation.Memory)))
+			Failure = "free of remaining allocation failed";
+	}
+	if (Failure.empty())
+		Failure = CheckMetadata(Allocator, {}, IsCoalesced);
+	if (Failure.empty() && Allocator.GetFreeSpaceSize() != Allocator.GetTotalSize())
+		Failure = "allocator isn't empty after all frees";
+	return Failure;
+}
+
+// Free finds the allocation by its address only, interior and foreign pointers are rejected.
+// Boundary tags are read in front of the pointer, so pointers outside of the allocator aren't checked with them
+template<typename AllocatorType>
+std::string TestFreeByAddress(bool IsForeignPointerChecked = true)
+{
+	AllocatorType Allocator{ 64 * 1024 };
+	std::mt19937 Random{ 11 };
+	std::vector<TestAllocation> Allocations{};
+	for (int allocationIndex = 0; allocationIndex < 1000; allocationIndex++)
+	{
+		TestAllocation Allocation{};
+		Allocation.Size = Random() % 1024 + 64;
+		Allocation.Memory = (uint8*)Allocator.Allocate((uint32)Allocation.Size);
+		if (Allocation.Memory == nullptr)
+			return "allocation failed";
+		Allocations.push_back(Allocation);
+	}
+
+	int Local = 0;
+	if (Allocator.Free(nullptr) || (IsForeignPointerChecked && Allocator.Free(&Local)) || Allocator.Free(Allocations[0].Memory + 1))
+		return "free of pointer which wasn't returned by Allocate succeeded";
+
+	std::shuffle(Allocations.begin(), Allocations.end(), Random);
+	while (!Allocations.empty())
+	{
+		void* Memory = Allocations.back().Memory;
+		Allocations.pop_back();
+		if (!Allocator.Free(Memory) || Allocator.Free(Memory))
+			return "free failed or double free succeeded";
+		if (Allocations.size() % 100 == 0)
+		{
+			std::string Failure = CheckMetadata(Allocator, Allocations);
+			if (!Failure.empty())
+				return Failure;
+		}
+	}
+	return Allocator.GetFreeSpaceSize() == Allocator.GetTotalSize() ? std::string{} : "allocator isn't empty after all frees";
+}
+
+// Free holes of the same size class as the request: the hole which fits is freed first, so it's the last one in the bucket.
+// IsGrown tells whether Allocate grew the allocator instead of using the fitting hole
+template<typename AllocatorType>
+std::string AllocateAfterSmallerHoles(uint32 SmallerHolesCount, bool& IsGrown)
+{
+	const uint32 FittingHoleSize = 1086, SmallerHoleSize = 1030, SeparatorSize = 300, RequestSize = 1080;
+	AllocatorType Allocator{ FittingHoleSize + SeparatorSize + SmallerHolesCount * (SmallerHoleSize + SeparatorSize) };
+	std::vector<TestAllocation> Allocations{};
+	for (uint32 holeIndex = 0; holeIndex <= SmallerHolesCount; holeIndex++)
+	{
+		for (uint32 Size : { holeIndex == 0 ? FittingHoleSize : SmallerHoleSize, SeparatorSize })
+		{
+			TestAllocation Allocation{};
+			Allocation.Size = Size;
+			Allocation.Tag = (uint8)Allocations.size();
+			Allocation.Memory = (uint8*)Allocator.Allocate(Size);
+			if (Allocation.Memory == nullptr)
+				return "allocation failed";
+			std::memset(Allocation.Memory, Allocation.Tag, Size);
+			Allocations.push_back(Allocation);
+		}
+	}
+	if (Allocator.GetFreeSpaceSize() != 0)
+		return "region isn't filled by the allocations";
+
+	// Holes are at even indexes, fitting hole goes first
+	std::vector<TestAllocation> Separators{};
+	for (size_t allocationIndex = 0; allocationIndex < Allocations.size(); allocationIndex++)
+	{
+		if (allocationIndex % 2 == 1)
+			Separators.push_back(Allocations[allocationIndex]);
+		else if (!Allocator.Free(Allocations[allocationIndex].Memory))
+			return "free failed";
+	}
+
+	const uint32 TotalSizeBefore = Allocator.GetTotalSize();
+	TestAllocation Allocation{};
+	Allocation.Size = RequestSize;
+	Allocation.Tag = 0xAB;
+	Allocation.Memory = (uint8*)Allocator.Allocate(RequestSize);
+	if (Allocation.Memory == nullptr)
+		return "allocation failed";
+	std::memset(Allocation.Memory, Allocation.Tag, RequestSize);
+	for (const TestAllocation& Separator : Separators)
+	{
+		if (!IsAllocationIntact(Separator))
+			return "allocation overwrote its neighbor, block is too small";
+	}
+	Separators.push_back(Allocation);
+
+	IsGrown = Allocator.GetTotalSize() != TotalSizeBefore;
+	if (!IsGrown && Allocation.Memory != Allocations[0].Memory)
+		return "allocation without growth isn't placed into the fitting hole";
+	return CheckMetadata(Allocator, Separators);
+}
+
+// Only the first BucketScanLimit nodes of the bucket of the request's own size class are checked,
+// the fitting hole behind them is skipped on purpose and the allocator grows, a too small hole is never returned
+std::string TestSegregatedFitScanLimit()
+{
+	using AllocatorType = DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SegregatedFitIndex>;
+	bool IsGrown = false;
+	std::string Failure = AllocateAfterSmallerHoles<AllocatorType>(3, IsGrown);
+	if (!Failure.empty() || IsGrown)
+		return Failure.empty() ? "fitting hole within the scan limit isn't found" : Failure;
+	Failure = AllocateAfterSmallerHoles<AllocatorType>(SegregatedFitIndex::BucketScanLimit + 1, IsGrown);
+	if (!Failure.empty() || !IsGrown)
+		return Failure.empty() ? "fitting hole beyond the scan limit is found, scan isn't bounded" : Failure;
+	return {};
+}
+
+// Holes of the given sizes separated by live blocks in a region which is filled completely, then one allocation of RequestSize.
+// HoleIndex is the index of the hole which the allocation is placed into, or HoleSizes.size() if it isn't placed into any of them
+template<typename AllocatorType>
+std::string AllocateIntoHoles(const std::vector<uint32>& HoleSizes, uint32 RequestSize, size_t& HoleIndex)
+{
+	const uint32 SeparatorSize = 300;
+	uint32 RegionSize = 0;
+	for (uint32 HoleSize : HoleSizes)
+		RegionSize += HoleSize + SeparatorSize;
+	AllocatorType Allocator{ RegionSize };
+
+	std::vector<TestAllocation> Holes{}, Separators{};
+	for (uint32 HoleSize : HoleSizes)
+	{
+		TestAllocation Hole{ (uint8*)Allocator.Allocate(HoleSize), HoleSize, 0 };
+		TestAllocation Separator{ (uint8*)Allocator.Allocate(SeparatorSize), SeparatorSize, (uint8)Separators.size() };
+		if (Hole.Memory == nullptr || Separator.Memory == nullptr)
+			return "allocation failed";
+		std::memset(Separator.Memory, Separator.Tag, SeparatorSize);
+		Holes.push_back(Hole);
+		Separators.push_back(Separator);
+	}
+	for (const TestAllocation& Hole : Holes)
+	{
+		if (!Allocator.Free(Hole.Memory))
+			return "free failed";
+	}
+
+	TestAllocation Allocation{};
+	Allocation.Size = RequestSize;
+	Allocation.Tag = 0xAB;
+	Allocation.Memory = (uint8*)Allocator.Allocate(RequestSize);
+	if (Allocation.Memory == nullptr)
+		return "allocation failed";
+	std::memset(Allocation.Memory, Allocation.Tag, RequestSize);
+	for (const TestAllocation& Separator : Separators)
+	{
+		if (!IsAllocationIntact(Separator))
+			return "allocation overwrote its neighbor";
+	}
+	Separators.push_back(Allocation);
+
+	for (HoleIndex = 0; HoleIndex < Holes.size() && Holes[HoleIndex].Memory != Allocation.Memory; HoleIndex++);
+	return CheckMetadata(Allocator, Separators);
+}
+
+// Tree finds the smallest hole which fits, not the first one and not the one of the closest size
+std::string TestSizeOrderedTreeBestFit()
+{
+	size_t HoleIndex = 0;
+	std::string Failure = AllocateIntoHoles<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SizeOrderedTreeIndex>>({ 300, 200, 250, 1000, 219 }, 220, HoleIndex);
+	if (Failure.empty() && HoleIndex != 2)
+		Failure = "allocation isn't placed into the smallest hole which fits";
+	return Failure;
+}
+
+// Free list holds only the holes, best fit among them is reused and the allocator doesn't grow
+std::string TestExplicitFreeListBestFit()
+{
+	size_t HoleIndex = 0;
+	std::string Failure = AllocateIntoHoles<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>>>({ 1000, 300, 200, 250 }, 220, HoleIndex);
+	if (Failure.empty() && HoleIndex != 3)
+		Failure = "allocation isn't placed into the smallest hole which fits";
+	return Failure;
+}
+
+// Hole taken by the policy, LinearScanIndex walks holes in address order, ExplicitFreeListIndex from the last freed one
+template<typename AllocatorType>
+std::string CheckFitPolicy(const char* PolicyName, const std::vector<uint32>& HoleSizes, size_t ExpectedHoleIndex)
+{
+	size_t HoleIndex = 0;
+	std::string Failure = AllocateIntoHoles<AllocatorType>(HoleSizes, 220, HoleIndex);
+	if (Failure.empty() && HoleIndex != ExpectedHoleIndex)
+		Failure = std::string{ PolicyName } + " took hole " + std::to_string(HoleIndex) + " instead of " + std::to_string(ExpectedHoleIndex);
+	return Failure;
+}
+
+// Two allocations from three equal holes, the first one is freed again between them, so it's the head of the free list again.
+// FirstFit takes it again, NextFit continues from the hole after it
+template<typename FitPolicy>
+std::string AllocateAfterRefree(size_t& HoleIndex)
+{
+	DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<FitPolicy>> Allocator{ 6 * 300 };
+	std::vector<uint8*> Blocks{};
+	for (int blockIndex = 0; blockIndex < 6; blockIndex++)
+		Blocks.push_back((uint8*)Allocator.Allocate(300));
+	for (int blockIndex = 0; blockIndex < 6; blockIndex += 2)
+	{
+		if (!Allocator.Free(Blocks[blockIndex]))
+			return "free failed";
+	}
+	if (!Allocator.Free(Allocator.Allocate(220)))
+		return "free failed";
+	uint8* Memory = (uint8*)Allocator.Allocate(220);
+	for (HoleIndex = 0; HoleIndex < Blocks.size() && Blocks[HoleIndex] != Memory; HoleIndex++);
+	return {};
+}
+
+std::string TestFitPolicies()
+{
+	const std::vector<uint32> AddressOrderedHoles{ 1000, 300, 200, 250, 230 };
+	const std::vector<uint32> FreeOrderedHoles{ 230, 250, 200, 300, 1000 };
+	using GoodFit32 = GoodFit<32>;
+	std::string Failure{};
+	for (std::string PolicyFailure : {
+		CheckFitPolicy<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, LinearScanIndex<BestFit>>>("LinearScan BestFit", AddressOrderedHoles, 4),
+		CheckFitPolicy<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, LinearScanIndex<FirstFit>>>("LinearScan FirstFit", AddressOrderedHoles, 0),
+		CheckFitPolicy<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, LinearScanIndex<GoodFit32>>>("LinearScan GoodFit", AddressOrderedHoles, 3),
+		CheckFitPolicy<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<BestFit>>>("ExplicitFreeList BestFit", FreeOrderedHoles, 0),
+		CheckFitPolicy<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<FirstFit>>>("ExplicitFreeList FirstFit", FreeOrderedHoles, 4),
+		CheckFitPolicy<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<GoodFit32>>>("ExplicitFreeList GoodFit", FreeOrderedHoles, 1) })
+	{
+		if (Failure.empty())
+			Failure = PolicyFailure;
+	}
+
+	size_t FirstFitHoleIndex = 0, NextFitHoleIndex = 0;
+	if (Failure.empty())
+		Failure = AllocateAfterRefree<FirstFit>(FirstFitHoleIndex);
+	if (Failure.empty())
+		Failure = AllocateAfterRefree<NextFit>(NextFitHoleIndex);
+	if (Failure.empty() && (FirstFitHoleIndex != 4 || NextFitHoleIndex != 2))
+		Failure = "NextFit doesn't continue from the roving pointer";
+	return Failure;
+}
+
+// Block between two free blocks merges with both of them on free, whatever the order of frees is
+std::string TestCoalesceBothNeighbours()
+{
+	const uint32 BlockSize = 300;
+	for (const std::vector<int>& FreeOrder : std::vector<std::vector<int>>{ { 0, 2, 1 }, { 2, 0, 1 }, { 1, 0, 2 }, { 1, 2, 0 } })
+	{
+		DynamicAllocator<> Allocator{ 4 * BlockSize };
+		std::vector<uint8*> Blocks{};
+		for (int blockIndex = 0; blockIndex < 4; blockIndex++)
+			Blocks.push_back((uint8*)Allocator.Allocate(BlockSize));
+		for (int blockIndex : FreeOrder)
+		{
+			if (!Allocator.Free(Blocks[blockIndex]))
+				return "free failed";
+		}
+
+		std::string Failure = CheckMetadata(Allocator, { TestAllocation{ Blocks[3], BlockSize, 0 } });
+		std::vector<StatsNode> Nodes{};
+		std::vector<size_t> FreeIDs{};
+		ParseStats(Allocator.GetAllocatorStats(), Nodes, FreeIDs);
+		if (Failure.empty() && (Nodes.size() != 2 || GetField(Nodes[0], "size") != 3 * BlockSize))
+			Failure = "freed blocks aren't merged into one node";
+		if (!Failure.empty())
+			return Failure;
+	}
+	return {};
+}
+
+// Interior pointers of allocations in several regions find their allocation, addresses inside of free blocks and foreign addresses don't
+template<typename AllocatorType>
+std::string TestFindAllocation()
+{
+	AllocatorType Allocator{ 4096 };
+	std::vector<TestAllocation> Allocations{};
+	for (uint32 Size : { 1000u, 3000u, 20000u, 100u, 40000u, 500u, 9000u, 700u })
+	{
+		// Every other allocation is placed into a new region
+		if (Allocations.size() % 2 == 0)
+			Allocator.Resize(Allocator.GetTotalSize() + Size);
+		TestAllocation Allocation{ (uint8*)Allocator.Allocate(Size), Size, 0 };
+		if (Allocation.Memory == nullptr)
+			return "allocation failed";
+		Allocations.push_back(Allocation);
+	}
+
+	for (const TestAllocation& Allocation : Allocations)
+	{
+		for (size_t Offset : { (size_t)0, (size_t)1, Allocation.Size / 2, Allocation.Size - 1 })
+		{
+			if (Allocator.FindAllocation(Allocation.Memory + Offset) != Allocation.Memory)
+				return "interior pointer at offset " + std::to_string(Offset) + " of " + std::to_string(Allocation.Size) + " bytes isn't found";
+		}
+	}
+
+	int Local = 0;
+	if (Allocator.FindAllocation(nullptr) != nullptr || Allocator.FindAllocation(&Local) != nullptr)
+		return "foreign address is found";
+
+	// Pages of the freed block keep the hints to their old nodes
+	for (size_t allocationIndex : { 2, 4 })
+	{
+		const TestAllocation& Allocation = Allocations[allocationIndex];
+		if (!Allocator.Free(Allocation.Memory))
+			return "free failed";
+		for (size_t Offset : { (size_t)0, Allocation.Size / 2, Allocation.Size - 1 })
+		{
+			if (Allocator.FindAllocation(Allocation.Memory + Offset) != nullptr)
+				return "address inside of a free block is found";
+		}
+	}
+	return Allocator.FindAllocation(Allocations[3].Memory + 50) == Allocations[3].Memory ? std::string{} : "allocation next to a free block isn't found";
+}
+
+// Blocks are powers of two aligned to their size from the start of the region, freed blocks merge back into the whole region
+std::string TestBuddyBlocks()
+{
+	const uint32 RegionSize = 64 * 1024;
+	DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, BuddyIndex<>> Allocator{ RegionSize };
+	std::mt19937 Random{ 9 };
+	std::vector<TestAllocation> Allocations{};
+	for (uint32 AllocatedSize = 0; AllocatedSize < RegionSize / 2;)
+	{
+		TestAllocation Allocation{};
+		Allocation.Size = Random() % 2000 + 1;
+		Allocation.Tag = (uint8)Random();
+		Allocation.Memory = (uint8*)Allocator.Allocate((uint32)Allocation.Size);
+		if (Allocation.Memory == nullptr)
+			return "allocation failed";
+		std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+		Allocations.push_back(Allocation);
+		AllocatedSize += (uint32)Allocation.Size;
+	}
+	if (Allocator.GetTotalSize() != RegionSize)
+		return "allocator grew while the region has free space";
+
+	std::vector<StatsNode> Nodes{};
+	std::vector<size_t> FreeIDs{};
+	ParseStats(Allocator.GetAllocatorStats(), Nodes, FreeIDs);
+	const uintptr_t RegionAddress = GetField(Nodes[0], "NodeAddress");
+	for (const StatsNode& Node : Nodes)
+	{
+		const size_t Size = GetField(Node, "size");
+		if ((Size & (Size - 1)) != 0 || (GetField(Node, "NodeAddress") - RegionAddress) % Size != 0)
+			return "block of " + std::to_string(Size) + " bytes isn't a power of two aligned to its size";
+	}
+	std::string Failure = CheckMetadata(Allocator, Allocations, false);
+	if (!Failure.empty())
+		return Failure;
+
+	std::shuffle(Allocations.begin(), Allocations.end(), Random);
+	for (const TestAllocation& Allocation : Allocations)
+	{
+		if (!IsAllocationIntact(Allocation) || !Allocator.Free(Allocation.Memory))
+			return "free failed";
+	}
+	Nodes.clear();
+	ParseStats(Allocator.GetAllocatorStats(), Nodes, FreeIDs);
+	if (Nodes.size() != 1 || Allocator.Allocate(RegionSize) == nullptr || Allocator.GetTotalSize() != RegionSize)
+		return "freed blocks aren't merged back into the whole region";
+	return {};
+}
+
+// Offsets of allocations for the same random steps, region is big enough to hold all of them
+template<typename AllocatorType>
+std::vector<ptrdiff_t> GetAllocationOffsets(uint32 Seed)
+{
+	AllocatorType Allocator{ 4 * 1024 * 1024 };
+	std::mt19937 Random{ Seed };
+	std::vector<uint8*> Allocations{};
+	std::vector<ptrdiff_t> Offsets{};
+	uint8* RegionMemory = nullptr;
+	for (int step = 0; step < 5000; step++)
+	{
+		if (Random() % 1000 < 550 || Allocations.empty())
+		{
+			Allocations.push_back((uint8*)Allocator.Allocate(Random() % 2048 + 1));
+			if (RegionMemory == nullptr)
+				RegionMemory = Allocations.back();
+			Offsets.push_back(Allocations.back() - RegionMemory);
+		}
+		else
+		{
+			const size_t allocationIndex = Random() % Allocations.size();
+			Allocator.Free(Allocations[allocationIndex]);
+			Allocations[allocationIndex] = Allocations.back();
+			Allocations.pop_back();
+		}
+	}
+	return Offsets;
+}
+
+// Layout of the metadata doesn't change the decisions of the allocator
+std::string TestSoAMatchesAoS()
+{
+	using AoSAllocator = DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, HashAddressIndex, AoSNodeStorage>;
+	using SoAAllocator = DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, HashAddressIndex, SoANodeStorage>;
+	return GetAllocationOffsets<AoSAllocator>(10) == GetAllocationOffsets<SoAAllocator>(10) ? std::string{} : "SoA storage places allocations differently from AoS";
+}
+
+// Smallest hole which fits is found among more holes than one block of the search kernel holds
+std::string TestVectorizedBestFit()
+{
+	std::vector<uint32> HoleSizes{};
+	for (uint32 HoleSize = 256; HoleSize < 256 + 150 * 7; HoleSize += 7)
+		HoleSizes.push_back(HoleSize);
+	std::shuffle(HoleSizes.begin(), HoleSizes.end(), std::mt19937{ 12 });
+
+	const uint32 RequestSize = 700;
+	size_t HoleIndex = 0;
+	std::string Failure = AllocateIntoHoles<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, VectorizedBestFitIndex, HashAddressIndex, SoANodeStorage>>(HoleSizes, RequestSize, HoleIndex);
+	const size_t ExpectedHoleIndex = std::find(HoleSizes.begin(), HoleSizes.end(), 704u) - HoleSizes.begin();
+	if (Failure.empty() && HoleIndex != ExpectedHoleIndex)
+		Failure = "allocation isn't placed into the smallest hole which fits";
+	return Failure;
+}
+
+// Elements keep their addresses while the array grows by chunks
+std::string TestChunkedArrayStability()
+{
+	ChunkedArray<uint32> Array{};
+	std::vector<const uint32*> Addresses{};
+	for (uint32 index = 0; index < 5 * ChunkedArray<uint32>::ChunkSize; index++)
+	{
+		Array.push_back(index);
+		Addresses.push_back(&Array[index]);
+	}
+	Array.resize(Array.size() + 3 * ChunkedArray<uint32>::ChunkSize, 7);
+	for (uint32 index = 0; index < Addresses.size(); index++)
+	{
+		if (Addresses[index] != &Array[index] || *Addresses[index] != index)
+			return "element moved or changed after growth";
+	}
+	return Array.back() == 7 ? std::string{} : "new elements aren't set to the value";
+}
+
+// Allocations far beyond MaxAllocations are still found by Free, the address index grows one bucket at a time
+std::string TestGrowthPastReservation()
+{
+	DynamicAllocator<> Allocator{ 64 * 1024, 16 };
+	std::vector<TestAllocation> Allocations{};
+	for (uint32 allocationIndex = 0; allocationIndex < 20000; allocationIndex++)
+	{
+		TestAllocation Allocation{ (uint8*)Allocator.Allocate(64), 64, (uint8)allocationIndex };
+		if (Allocation.Memory == nullptr)
+			return "allocation failed";
+		std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+		Allocations.push_back(Allocation);
+	}
+	std::string Failure = CheckMetadata(Allocator, Allocations);
+	std::shuffle(Allocations.begin(), Allocations.end(), std::mt19937{ 14 });
+	for (const TestAllocation& Allocation : Allocations)
+	{
+		if (Failure.empty() && (!IsAllocationIntact(Allocation) || !Allocator.Free(Allocation.Memory) || Allocator.Free(Allocation.Memory)))
+			Failure = "free failed or double free succeeded";
+	}
+	return Failure;
+}
+
+// Released node IDs are reused at once, so repeated cycles of allocations don't make new nodes
+std::string TestNodeIDsReuse()
+{
+	DynamicAllocator<> Allocator{ 64 * 1024 };
+	std::mt19937 Random{ 18 };
+	size_t MaxNodeID = 0;
+	for (int cycle = 0; cycle < 200; cycle++)
+	{
+		std::vector<void*> Allocations{};
+		for (int allocationIndex = 0; allocationIndex < 100; allocationIndex++)
+			Allocations.push_back(Allocator.Allocate(Random() % 256 + 1));
+		std::vector<StatsNode> Nodes{};
+		std::vector<size_t> FreeIDs{};
+		ParseStats(Allocator.GetAllocatorStats(), Nodes, FreeIDs);
+		for (const StatsNode& Node : Nodes)
+			MaxNodeID = std::max(MaxNodeID, GetField(Node, "ID"));
+		std::shuffle(Allocations.begin(), Allocations.end(), Random);
+		for (void* Memory : Allocations)
+			Allocator.Free(Memory);
+	}
+	return MaxNodeID <= 101 ? std::string{} : "node ID " + std::to_string(MaxNodeID) + " is used for at most 101 nodes";
+}
+
+// After compaction IDs of nodes are their positions in the list, no invalid nodes are kept and the indexes still work
+template<typename AllocatorType>
+std::string TestCompactMetadata(bool IsCoalesced = true)
+{
+	AllocatorType Allocator{ 64 * 1024 };
+	std::mt19937 Random{ 19 };
+	std::vector<TestAllocation> Allocations{};
+	for (int step = 0; step < 4000; step++)
+	{
+		if (Random() % 3 != 0 || Allocations.empty())
+		{
+			TestAllocation Allocation{};
+			Allocation.Size = Random() % 1024 + 1;
+			Allocation.Tag = (uint8)Random();
+			Allocation.Memory = (uint8*)Allocator.Allocate((uint32)Allocation.Size);
+			if (Allocation.Memory == nullptr)
+				return "allocation failed";
+			std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+			Allocations.push_back(Allocation);
+		}
+		else
+		{
+			const size_t allocationIndex = Random() % Allocations.size();
+			Allocator.Free(Allocations[allocationIndex].Memory);
+			Allocations[allocationIndex] = Allocations.back();
+			Allocations.pop_back();
+		}
+	}
+
+	Allocator.CompactMetadata();
+	std::vector<StatsNode> Nodes{};
+	std::vector<size_t> FreeIDs{};
+	ParseStats(Allocator.GetAllocatorStats(), Nodes, FreeIDs);
+	for (size_t nodeIndex = 0; nodeIndex < Nodes.size(); nodeIndex++)
+	{
+		if (GetField(Nodes[nodeIndex], "ID") != nodeIndex)
+			return "node ID isn't its position in the list";
+	}
+	if (!FreeIDs.empty())
+		return "invalid nodes are kept";
+	std::string Failure = CheckMetadata(Allocator, Allocations, IsCoalesced);
+	for (const TestAllocation& Allocation : Allocations)
+	{
+		if (Failure.empty() && (!IsAllocationIntact(Allocation) || Allocator.FindAllocation(Allocation.Memory) != Allocation.Memory || !Allocator.Free(Allocation.Memory)))
+			Failure = "allocation isn't found after compaction";
+	}
+	return Failure.empty() && Allocator.Allocate(1024) == nullptr ? "allocation failed" : Failure;
+}
+
+// Metadata grown by a burst of allocations is released by TrimMetadata once they are freed,
+// region holds all of them, otherwise nodes of the added regions are left
+template<typename AllocatorType>
+std::string TestTrimMetadata()
+{
+	AllocatorType Allocator{ 2 * 1024 * 1024, 256 };
+	const size_t InitialMetadataSize = Allocator.GetMetadataSize();
+	std::vector<void*> Allocations{};
+	for (int allocationIndex = 0; allocationIndex < 20000; allocationIndex++)
+		Allocations.push_back(Allocator.Allocate(64));
+	const size_t BurstMetadataSize = Allocator.GetMetadataSize();
+	for (void* Memory : Allocations)
+		Allocator.Free(Memory);
+
+	// Trimmed metadata is no bigger than it was before the burst
+	Allocator.TrimMetadata();
+	if (Allocator.GetMetadataSize() > InitialMetadataSize)
+		return "metadata of " + std::to_string(Allocator.GetMetadataSize()) + " bytes is left from " + std::to_string(BurstMetadataSize);
+
+	std::vector<TestAllocation> TrimmedAllocations{};
+	for (uint32 Size = 1; Size < 4000; Size += 97)
+		TrimmedAllocations.push_back(TestAllocation{ (uint8*)Allocator.Allocate(Size), Size, 0 });
+	return CheckMetadata(Allocator, TrimmedAllocations);
+}
+
+// Request which would overflow the total size of uint32 sizes fails, the allocator neither grows nor shrinks
+std::string TestSizeOverflow()
+{
+	DynamicAllocator<> Allocator{ 64 * 1024 };
+	TestAllocation Allocation{ (uint8*)Allocator.Allocate(1000), 1000, 0x5A };
+	std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+	if (Allocator.Allocate(UINT32_MAX - 100) != nullptr)
+		return "allocation which overflows total size succeeded";
+	if (Allocator.GetTotalSize() != 64 * 1024 || !IsAllocationIntact(Allocation))
+		return "failed allocation changed the allocator";
+	return CheckMetadata(Allocator, { Allocation });
+}
+
+// When all 16-bit node IDs are taken allocations fail, nothing is corrupted and a free makes allocation possible again
+std::string TestNodeIDsExhaustion()
+{
+	using AllocatorType = DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, HashAddressIndex, AoSNodeStorage, uint32, uint16>;
+	AllocatorType Allocator{ 1024 * 1024 };
+	std::vector<TestAllocation> Allocations{};
+	for (;;)
+	{
+		TestAllocation Allocation{ (uint8*)Allocator.Allocate(64), 64, (uint8)Allocations.size() };
+		if (Allocation.Memory == nullptr)
+			break;
+		std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+		Allocations.push_back(Allocation);
+		if (Allocations.size() > 0xFFFF)
+			return "more allocations than node IDs";
+	}
+	if (Allocations.size() < 0xFFFF - 16)
+		return "allocation failed with " + std::to_string(Allocations.size()) + " allocations";
+
+	std::string Failure = CheckMetadata(Allocator, Allocations);
+	if (!Failure.empty())
+		return Failure;
+	for (const TestAllocation& Allocation : Allocations)
+	{
+		if (!IsAllocationIntact(Allocation))
+			return "memory of allocation is overwritten";
+	}
+
+	if (!Allocator.Free(Allocations.back().Memory))
+		return "free failed";
+	Allocations.back().Memory = (uint8*)Allocator.Allocate(64);
+	if (Allocations.back().Memory == nullptr)
+		return "allocation failed after free";
+	return CheckMetadata(Allocator, Allocations);
+}
+
+// Aligned allocations mixed with unaligned ones, padding in front of aligned allocation stays free for other allocations
+template<typename AllocatorType>
+std::string TestAllocateAligned()
+{
+	AllocatorType Allocator{ 64 * 1024 };
+	if (Allocator.AllocateAligned(64, 0) != nullptr || Allocator.AllocateAligned(64, 48) != nullptr
+		|| Allocator.AllocateAligned(64, 2 * MaxAllocationAlignment) != nullptr || Allocator.AllocateAligned(0, 64) != nullptr)
+		return "allocation with invalid alignment or size succeeded";
+
+	TestAllocation PageAllocation{ (uint8*)Allocator.AllocateAligned(100, MaxAllocationAlignment), 100, 0 };
+	if (PageAllocation.Memory == nullptr || (uintptr_t)PageAllocation.Memory % MaxAllocationAlignment != 0)
+		return "allocation isn't aligned";
+	// Padding is at least MinAllocSizeRequirement, node of the allocation may also hold the header of occupied index
+	if (Allocator.GetTotalSize() - Allocator.GetFreeSpaceSize() >= PageAllocation.Size + MinAllocSizeRequirement)
+		return "padding isn't left free";
+	if (!Allocator.Free(PageAllocation.Memory))
+		return "free failed";
+
+	std::mt19937 Random{ 25 };
+	std::vector<TestAllocation> Allocations{};
+	for (int step = 0; step < 3000; step++)
+	{
+		if (Random() % 3 != 0 || Allocations.empty())
+		{
+			const bool IsAligned = Random() % 2 == 0;
+			const uint32 Alignment = 1u << (Random() % 13);
+			TestAllocation Allocation{};
+			Allocation.Size = Random() % 2000 + 1;
+			Allocation.Tag = (uint8)Random();
+			Allocation.Memory = (uint8*)(IsAligned ? Allocator.AllocateAligned((uint32)Allocation.Size, Alignment) : Allocator.Allocate((uint32)Allocation.Size));
+			if (Allocation.Memory == nullptr)
+				return "allocation failed";
+			if (IsAligned && (uintptr_t)Allocation.Memory % Alignment != 0)
+				return "allocation isn't aligned to " + std::to_string(Alignment);
+			std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+			Allocations.push_back(Allocation);
+		}
+		else
+		{
+			const size_t allocationIndex = Random() % Allocations.size();
+			if (!IsAllocationIntact(Allocations[allocationIndex]) || !Allocator.Free(Allocations[allocationIndex].Memory))
+				return "free failed";
+			Allocations[allocationIndex] = Allocations.back();
+			Allocations.pop_back();
+		}
+
+		if (step % 100 == 0)
+		{
+			std::string Failure = CheckMetadata(Allocator, Allocations);
+			if (!Failure.empty())
+				return Failure + " at step " + std::to_string(step);
+		}
+	}
+	return CheckMetadata(Allocator, Allocations);
+}
+
+// Every pointer is aligned to the granularity and every block size is a multiple of it, in all regions
+template<typename AllocatorType>
+std::string TestGranularBlocks()
+{
+	const uint32 Granularity = 64;
+	AllocatorType Allocator{ 10000 };
+	std::mt19937 Random{ 26 };
+	std::vector<TestAllocation> Allocations{};
+	for (int step = 0; step < 2000; step++)
+	{
+		if (Random() % 3 != 0 || Allocations.empty())
+		{
+			TestAllocation Allocation{ (uint8*)Allocator.Allocate(Random() % 700 + 1), 0, 0 };
+			if (Allocation.Memory == nullptr || (uintptr_t)Allocation.Memory % Granularity != 0)
+				return "pointer isn't aligned to the granularity";
+			Allocations.push_back(Allocation);
+		}
+		else
+		{
+			const size_t allocationIndex = Random() % Allocations.size();
+			Allocator.Free(Allocations[allocationIndex].Memory);
+			Allocations[allocationIndex] = Allocations.back();
+			Allocations.pop_back();
+		}
+	}
+
+	std::vector<StatsNode> Nodes{};
+	std::vector<size_t> FreeIDs{};
+	ParseStats(Allocator.GetAllocatorStats(), Nodes, FreeIDs);
+	for (const StatsNode& Node : Nodes)
+	{
+		if (GetField(Node, "size") % Granularity != 0)
+			return "block size isn't a multiple of the granularity";
+	}
+	return CheckMetadata(Allocator, Allocations);
+}
+
+#if defined(__linux__)
+// Pages of a big block freed between two live allocations are given back to the kernel, both neighbours stay intact
+std::string TestMmapPageRelease()
+{
+	const size_t PageSize = (size_t)sysconf(_SC_PAGESIZE);
+	DynamicAllocator<DYNAMIC_ALLOCATOR_MMAP> Allocator{ 4 * 1024 * 1024 };
+	TestAllocation Before{ (uint8*)Allocator.Allocate(1000), 1000, 0x11 };
+	TestAllocation Big{ (uint8*)Allocator.Allocate(1024 * 1024), 1024 * 1024, 0x22 };
+	TestAllocation After{ (uint8*)Allocator.Allocate(1000), 1000, 0x33 };
+	if (Before.Memory == nullptr || Big.Memory == nullptr || After.Memory == nullptr)
+		return "allocation failed";
+	for (const TestAllocation& Allocation : { Before, Big, After })
+		std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+
+	if (!Allocator.Free(Big.Memory))
+		return "free failed";
+	if (!IsAllocationIntact(Before) || !IsAllocationIntact(After))
+		return "release of the freed block overwrote its neighbours";
+
+	// Whole pages inside of the freed block aren't resident anymore
+	uint8* FirstPage = (uint8*)(((uintptr_t)Big.Memory + PageSize - 1) & ~(uintptr_t)(PageSize - 1));
+	const size_t PagesCount = (Big.Memory + Big.Size - FirstPage) / PageSize - 1;
+	std::vector<unsigned char> Residency(PagesCount);
+	if (mincore(FirstPage, PagesCount * PageSize, Residency.data()) != 0)
+		return "mincore failed";
+	for (unsigned char PageResidency : Residency)
+	{
+		if ((PageResidency & 1) != 0)
+			return "page of the freed block is still resident";
+	}
+
+	std::string Failure = CheckMetadata(Allocator, { Before, After });
+	TestAllocation Reused{ (uint8*)Allocator.Allocate(512 * 1024), 512 * 1024, 0x44 };
+	if (Failure.empty() && Reused.Memory == nullptr)
+		Failure = "allocation from the released block failed";
+	if (Failure.empty())
+	{
+		std::memset(Reused.Memory, Reused.Tag, Reused.Size);
+		Failure = CheckMetadata(Allocator, { Before, After, Reused });
+	}
+	return Failure.empty() && (!IsAllocationIntact(Before) || !IsAllocationIntact(After)) ? "allocation overwrote its neighbours" : Failure;
+}
+#endif
+
+#if defined(__linux__)
+// Regions take whole huge pages and start at 2MB aligned mappings, whether MAP_HUGETLB or the MADV_HUGEPAGE fallback is used
+std::string TestHugePages()
+{
+	using HugePages = DYNAMIC_ALLOCATOR_HUGE_PAGES;
+	DynamicAllocator<HugePages> Allocator{ 100000 };
+	if ((Allocator.GetTotalSize() + HugePages::HeaderSize) % HugePages::HugePageSize != 0)
+		return "total size " + std::to_string(Allocator.GetTotalSize()) + " isn't rounded to huge pages";
+
+	TestAllocation First{ (uint8*)Allocator.Allocate(1000), 1000, 0x11 };
+	if (First.Memory == nullptr || ((uintptr_t)First.Memory - HugePages::HeaderSize) % HugePages::HugePageSize != 0)
+		return "region doesn't start at a huge page";
+	const uint32 FirstRegionSize = Allocator.GetTotalSize();
+	TestAllocation Big{ (uint8*)Allocator.Allocate(3 * 1024 * 1024), 3 * 1024 * 1024, 0x22 };
+	TestAllocation Last{ (uint8*)Allocator.Allocate(1000), 1000, 0x33 };
+	if (Big.Memory == nullptr || Last.Memory == nullptr)
+		return "allocation failed";
+	if ((Allocator.GetTotalSize() - FirstRegionSize + HugePages::HeaderSize) % HugePages::HugePageSize != 0)
+		return "added region isn't rounded to huge pages";
+	for (const TestAllocation& Allocation : { First, Big, Last })
+		std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+
+	if (!Allocator.Free(Big.Memory) || !IsAllocationIntact(First) || !IsAllocationIntact(Last))
+		return "free failed or overwrote other allocations";
+	return CheckMetadata(Allocator, { First, Last });
+}
+#endif
+
+#if defined(__linux__)
+// Resize grows the region in place, so free space of all growth steps is one block. Shrink releases regions which are free,
+// ReservationSize of the arena smaller than the growth makes the allocator fall back to adding regions
+template<typename AllocatorType>
+std::string TestVirtualArena(size_t ReservationSize)
+{
+	const uint32 StepSize = 64 * 1024;
+	const bool IsSingleRegion = ReservationSize > 32 * StepSize;
+	AllocatorType Allocator{ StepSize };
+	std::vector<TestAllocation> Allocations{};
+	for (uint32 step = 0; step < 16; step++)
+	{
+		TestAllocation Allocation{ (uint8*)Allocator.Allocate(1000), 1000, (uint8)step };
+		if (Allocation.Memory == nullptr)
+			return "allocation failed";
+		std::memset(Allocation.Memory, Allocation.Tag, Allocation.Size);
+		Allocations.push_back(Allocation);
+		if (!Allocator.Resize(Allocator.GetTotalSize() + StepSize))
+			return "resize failed";
+	}
+	std::string Failure = CheckMetadata(Allocator, Allocations);
+	if (!Failure.empty())
+		return Failure;
+
+	// Only the first allocation stays, free space of its region is a single block
+	for (size_t allocationIndex = 1; allocationIndex < Allocations.size(); allocationIndex++)
+	{
+		if (!IsAllocationIntact(Allocations[allocationIndex]) || !Allocator.Free(Allocations[allocationIndex].Memory))
+			return "free failed";
+	}
+	Allocations.resize(1);
+	const uint32 TotalSize = Allocator.GetTotalSize();
+	void* Memory = nullptr;
+	if (IsSingleRegion)
+	{
+		Memory = Allocator.Allocate(Allocator.GetFreeSpaceSize());
+		if (Memory == nullptr || Allocator.GetTotalSize() != TotalSize)
+			return "free space of growth steps isn't coalesced";
+		if (!Allocator.Free(Memory))
+			return "free failed";
+	}
+
+	// Region with the allocation stays, regions added after the reservation ran out are released
+	Allocator.Resize(StepSize);
+	Failure = CheckMetadata(Allocator, Allocations);
+	if (!Failure.empty() || !IsAllocationIntact(Allocations[0]))
+		return Failure.empty() ? "shrink overwrote the allocation" : Failure;
+	if (Allocator.GetTotalSize() > ReservationSize)
+		return "free region isn't released by shrink";
+
+	if (!Allocator.Free(Allocations[0].Memory) || !Allocator.Resize(StepSize / 2) || Allocator.GetTotalSize() != 0)
+		return "free region isn't released by shrink";
+	Memory = Allocator.Allocate(5000);
+	if (Memory == nullptr || !Allocator.Free(Memory))
+		return "allocation after shrink failed";
+	return {};
+}
+#endif
+
+bool Report(const char* Name, const std::string& Failure)
+{
+	if (!Failure.empty())
+	{
+		std::cout << Name << ": FAILED, " << Failure << '\n';
+		return false;
+	}
+	std::cout << Name << ": ok\n";
+	return true;
+}
+
+int main()
+{
+	bool Passed = true;
+	Passed &= Report("Free by address", TestFreeByAddress<DynamicAllocator<>>());
+	Passed &= Report("Random steps", RunRandomSteps<DynamicAllocator<>>(1));
+	Passed &= Report("SegregatedFit scan limit", TestSegregatedFitScanLimit());
+	Passed &= Report("Random steps, SegregatedFit", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SegregatedFitIndex>>(2));
+	Passed &= Report("SizeOrderedTree best fit", TestSizeOrderedTreeBestFit());
+	Passed &= Report("Random steps, SizeOrderedTree", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SizeOrderedTreeIndex>>(3));
+	Passed &= Report("ExplicitFreeList best fit", TestExplicitFreeListBestFit());
+	Passed &= Report("Random steps, LinearScan", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, LinearScanIndex<>>>(4));
+	Passed &= Report("Fit policies", TestFitPolicies());
+	Passed &= Report("Random steps, NextFit", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<NextFit>>>(5));
+	Passed &= Report("Coalesce both neighbours", TestCoalesceBothNeighbours());
+	Passed &= Report("Free by address, BoundaryTag", TestFreeByAddress<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, BoundaryTagIndex>>(false));
+	Passed &= Report("Random steps, BoundaryTag", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, BoundaryTagIndex>>(7));
+	Passed &= Report("FindAllocation", TestFindAllocation<DynamicAllocator<>>());
+	Passed &= Report("FindAllocation, BoundaryTag", TestFindAllocation<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, BoundaryTagIndex>>());
+	Passed &= Report("FindAllocation, PageMap", TestFindAllocation<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, PageMapIndex>>());
+	Passed &= Report("Random steps, PageMap", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, PageMapIndex>>(8));
+	Passed &= Report("Buddy blocks", TestBuddyBlocks());
+	Passed &= Report("Random steps, Buddy", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, BuddyIndex<>>>(9, false));
+	Passed &= Report("SoA matches AoS", TestSoAMatchesAoS());
+	Passed &= Report("Random steps, SoA", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, HashAddressIndex, SoANodeStorage>>(10));
+	Passed &= Report("Random steps, SoA SegregatedFit", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SegregatedFitIndex, PageMapIndex, SoANodeStorage>>(11));
+	Passed &= Report("Vectorized best fit", TestVectorizedBestFit());
+	Passed &= Report("Random steps, VectorizedBestFit", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, VectorizedBestFitIndex, HashAddressIndex, SoANodeStorage>>(12));
+	Passed &= Report("Free by address, VectorizedAddress", TestFreeByAddress<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, VectorizedAddressIndex, SoANodeStorage>>());
+	Passed &= Report("Random steps, VectorizedAddress", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, VectorizedBestFitIndex, VectorizedAddressIndex, SoANodeStorage>>(13));
+	Passed &= Report("FindAllocation, Packed", TestFindAllocation<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, PageMapIndex, PackedNodeStorage>>());
+	Passed &= Report("Random steps, Packed", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, HashAddressIndex, PackedNodeStorage>>(14));
+	Passed &= Report("Random steps, Packed Buddy", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, BuddyIndex<>, BoundaryTagIndex, PackedNodeStorage>>(15, false));
+	Passed &= Report("ChunkedArray stability", TestChunkedArrayStability());
+	Passed &= Report("Growth past reservation", TestGrowthPastReservation());
+	Passed &= Report("Random steps, Lazy", RunRandomSteps<DynamicAllocator<>>(16, true, MetadataReservation::Lazy));
+	Passed &= Report("Random steps, Lazy Packed SegregatedFit", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SegregatedFitIndex, PageMapIndex, PackedNodeStorage>>(17, true, MetadataReservation::Lazy));
+	Passed &= Report("Node IDs reuse", TestNodeIDsReuse());
+	Passed &= Report("CompactMetadata", TestCompactMetadata<DynamicAllocator<>>());
+	Passed &= Report("CompactMetadata, SegregatedFit PageMap", TestCompactMetadata<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SegregatedFitIndex, PageMapIndex>>());
+	Passed &= Report("CompactMetadata, Buddy BoundaryTag Packed", TestCompactMetadata<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, BuddyIndex<>, BoundaryTagIndex, PackedNodeStorage>>(false));
+	Passed &= Report("TrimMetadata", TestTrimMetadata<DynamicAllocator<>>());
+	Passed &= Report("TrimMetadata, SegregatedFit PageMap Packed", TestTrimMetadata<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SegregatedFitIndex, PageMapIndex, PackedNodeStorage>>());
+	Passed &= Report("Size overflow", TestSizeOverflow());
+	Passed &= Report("Random steps, 64-bit sizes", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, HashAddressIndex, AoSNodeStorage, uint64>>(20));
+	Passed &= Report("Random steps, 64-bit sizes SegregatedFit PageMap", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SegregatedFitIndex, PageMapIndex, AoSNodeStorage, uint64>>(21));
+	Passed &= Report("Random steps, 64-bit sizes Buddy Packed", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, BuddyIndex<>, BoundaryTagIndex, PackedNodeStorage, uint64>>(22, false));
+	Passed &= Report("Node IDs exhaustion", TestNodeIDsExhaustion());
+	Passed &= Report("Random steps, 16-bit node IDs", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SegregatedFitIndex, BoundaryTagIndex, PackedNodeStorage, uint32, uint16>>(23));
+	Passed &= Report("Random steps, 64-bit node IDs", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, ExplicitFreeListIndex<>, PageMapIndex, AoSNodeStorage, uint64, uint64>>(24));
+	Passed &= Report("AllocateAligned", TestAllocateAligned<DynamicAllocator<>>());
+	Passed &= Report("AllocateAligned, SegregatedFit BoundaryTag", TestAllocateAligned<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SegregatedFitIndex, BoundaryTagIndex>>());
+	Passed &= Report("AllocateAligned, SizeOrderedTree PageMap Packed", TestAllocateAligned<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, SizeOrderedTreeIndex, PageMapIndex, PackedNodeStorage>>());
+	Passed &= Report("Granular blocks", TestGranularBlocks<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, GranularIndex<ExplicitFreeListIndex<>>>>());
+	Passed &= Report("Granular blocks, SegregatedFit BoundaryTag", TestGranularBlocks<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, GranularIndex<SegregatedFitIndex>, BoundaryTagIndex>>());
+	Passed &= Report("Random steps, Granular", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MALLOC, GranularIndex<ExplicitFreeListIndex<>>, PageMapIndex>>(27));
+#if defined(__linux__)
+	Passed &= Report("Mmap page release", TestMmapPageRelease());
+	Passed &= Report("Random steps, Mmap", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_MMAP, SegregatedFitIndex, PageMapIndex>>(28));
+#endif
+#if defined(__linux__)
+	Passed &= Report("Huge pages", TestHugePages());
+	Passed &= Report("Random steps, HugePages", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_HUGE_PAGES>>(29));
+#endif
+#if defined(__linux__)
+	Passed &= Report("Virtual arena, PageMap", TestVirtualArena<DynamicAllocator<DYNAMIC_ALLOCATOR_VIRTUAL_ARENA<>, ExplicitFreeListIndex<>, PageMapIndex>>((size_t)64 << 30));
+	Passed &= Report("Virtual arena, HashAddress", TestVirtualArena<DynamicAllocator<DYNAMIC_ALLOCATOR_VIRTUAL_ARENA<>, ExplicitFreeListIndex<>, HashAddressIndex>>((size_t)64 << 30));
+	Passed &= Report("Virtual arena, small reservation", TestVirtualArena<DynamicAllocator<DYNAMIC_ALLOCATOR_VIRTUAL_ARENA<256 * 1024>, SegregatedFitIndex, PageMapIndex>>(256 * 1024));
+	Passed &= Report("Random steps, VirtualArena PageMap", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_VIRTUAL_ARENA<>, ExplicitFreeListIndex<>, PageMapIndex>>(30));
+	Passed &= Report("Random steps, VirtualArena HashAddress", RunRandomSteps<DynamicAllocator<DYNAMIC_ALLOCATOR_VIRTUAL_ARENA<>, SizeOrderedTreeIndex, HashAddressIndex>>(31));
+#endif
+	return Passed ? 0 : 1;
+}